@@ -0,0 +1,218 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <random>
+
+#include "BaseImageCache.h"
+#include "Utilities.h"
+
+namespace {
+	char const magic[4]{'R', 'P', 'D', 'C'};
+	uint32_t const version = 5;
+
+	uint64_t mixMurmur(uint64_t value) {
+		value = (value ^ value >> 33) * 0xff51afd7ed558ccdULL;
+		value = (value ^ value >> 33) * 0xc4ceb9fe1a85ec53ULL;
+		return value ^ value >> 33;
+	}
+
+	uint64_t mixSplitMix(uint64_t value) {
+		value += 0x9e3779b97f4a7c15ULL;
+		value = (value ^ value >> 30) * 0xbf58476d1ce4e5b9ULL;
+		value = (value ^ value >> 27) * 0x94d049bb133111ebULL;
+		return value ^ value >> 31;
+	}
+
+	void writeEllipse(ostream& stream, RotatedRect const& ellipse) {
+		float const values[]{ellipse.center.x, ellipse.center.y, ellipse.size.width, ellipse.size.height, ellipse.angle};
+		stream.write(reinterpret_cast<char const*>(values), sizeof values);
+	}
+
+	RotatedRect readEllipse(istream& stream) {
+		float values[5];
+		stream.read(reinterpret_cast<char*>(values), sizeof values);
+		return RotatedRect(Point2f(values[0], values[1]), Size2f(values[2], values[3]), values[4]);
+	}
+
+	void writeImage(ostream& stream, Mat const& image) {
+		vector<uchar> buffer;
+		imencode(".png", image, buffer);
+		auto const& size = static_cast<uint32_t>(buffer.size());
+		stream.write(reinterpret_cast<char const*>(&size), sizeof size);
+		stream.write(reinterpret_cast<char const*>(buffer.data()), size);
+	}
+
+	Mat readImage(istream& stream) {
+		uint32_t size;
+		stream.read(reinterpret_cast<char*>(&size), sizeof size);
+		if (!stream || size > 1 << 28 || size > computeRemainingSize(stream))
+			return Mat();
+		vector<uchar> buffer(size);
+		stream.read(reinterpret_cast<char*>(buffer.data()), size);
+		return stream ? imdecode(buffer, IMREAD_GRAYSCALE) : Mat();
+	}
+}
+
+size_t BaseImageCache::hits_ = 0;
+
+size_t BaseImageCache::misses_ = 0;
+
+string BaseImageCache::directory_;
+
+deque<uint64_t> BaseImageCache::keys_;
+
+unordered_map<uint64_t, BaseImageCache::Entry> BaseImageCache::entries_;
+
+mutex BaseImageCache::mutex_;
+
+void BaseImageCache::analyze(Mat const& base, DesignContext& context, TeethModel& remediedTeeth, Mat (&remediedDesignImages)[2], TeethModel* const& teeth, Mat (*const& designImages)[2], Mat* const& baseImage) {
+	auto const& key = computeKey(base);
+	Entry entry;
+	auto isCached = false;
+	{
+		lock_guard<mutex> lock(mutex_);
+		auto const& tmpIt = entries_.find(key.hash);
+		if (tmpIt != entries_.end() && tmpIt->second.key == key) {
+			entry = tmpIt->second;
+			isCached = true;
+			++hits_;
+		}
+	}
+	if (!isCached) {
+		auto const& isLoaded = !directory_.empty() && load(getFileName(key), key, entry);
+		if (!isLoaded) {
+			entry.key = key;
+			Mat thisDesignImages[2], thisRemediedDesignImages[2];
+			analyzeBaseImage(base, context, entry.remediedTeeth, thisRemediedDesignImages, &entry.teeth, &thisDesignImages);
+			entry.designImage = thisDesignImages[0];
+			entry.remediedDesignImage = thisRemediedDesignImages[0];
+			entry.teethEllipse = context.teethEllipse;
+			entry.remediedTeethEllipse = context.remediedTeethEllipse;
+			if (!directory_.empty())
+				save(getFileName(key), entry);
+		}
+		lock_guard<mutex> lock(mutex_);
+		++(isLoaded ? hits_ : misses_);
+		insert(entry);
+	}
+	context.teethEllipse = entry.teethEllipse;
+	context.remediedTeethEllipse = entry.remediedTeethEllipse;
+	remediedTeeth = move(entry.remediedTeeth);
+	remediedDesignImages[0] = entry.remediedDesignImage.clone();
+	if (teeth)
+		*teeth = move(entry.teeth);
+	if (designImages)
+		(*designImages)[0] = entry.designImage.clone();
+	if (baseImage)
+		copyMakeBorder(base, *baseImage, 80, 80, 80, 80, BORDER_CONSTANT, Scalar::all(255));
+}
+
+void BaseImageCache::clear() {
+	lock_guard<mutex> lock(mutex_);
+	keys_.clear();
+	entries_.clear();
+	hits_ = misses_ = 0;
+}
+
+void BaseImageCache::setDirectory(string const& directory) { directory_ = directory; }
+
+size_t BaseImageCache::getHits() {
+	lock_guard<mutex> lock(mutex_);
+	return hits_;
+}
+
+size_t BaseImageCache::getMisses() {
+	lock_guard<mutex> lock(mutex_);
+	return misses_;
+}
+
+bool BaseImageCache::Key::operator==(Key const& key) const { return hash == key.hash && checkHash == key.checkHash && rows == key.rows && cols == key.cols && type == key.type; }
+
+BaseImageCache::Key BaseImageCache::computeKey(Mat const& image) {
+	auto hash = 14695981039346656037ULL, checkHash = 0x243f6a8885a308d3ULL;
+	auto const& mix = [&hash, &checkHash](uint64_t const& value) {
+		hash = mixMurmur(hash ^ value);
+		checkHash = mixSplitMix(checkHash + value);
+	};
+	mix(image.rows);
+	mix(image.cols);
+	mix(image.type());
+	auto const& rowSize = image.cols * image.elemSize();
+	for (auto i = 0; i < image.rows; ++i) {
+		auto const& row = image.ptr(i);
+		size_t j = 0;
+		for (uint64_t word; j + sizeof word <= rowSize; j += sizeof word) {
+			memcpy(&word, row + j, sizeof word);
+			mix(word);
+		}
+		for (; j < rowSize; ++j)
+			mix(row[j]);
+	}
+	return {hash, checkHash, image.rows, image.cols, image.type()};
+}
+
+string BaseImageCache::getFileName(Key const& key) {
+	char name[17];
+	snprintf(name, sizeof name, "%016llx", static_cast<unsigned long long>(key.hash));
+	return directory_ + '/' + name + ".rpdc";
+}
+
+bool BaseImageCache::load(string const& fileName, Key const& key, Entry& entry) {
+	ifstream stream(fileName, ios::binary);
+	char thisMagic[4];
+	uint32_t thisVersion;
+	stream.read(thisMagic, sizeof thisMagic);
+	stream.read(reinterpret_cast<char*>(&thisVersion), sizeof thisVersion);
+	stream.read(reinterpret_cast<char*>(&entry.key.hash), sizeof entry.key.hash);
+	stream.read(reinterpret_cast<char*>(&entry.key.checkHash), sizeof entry.key.checkHash);
+	stream.read(reinterpret_cast<char*>(&entry.key.rows), sizeof entry.key.rows);
+	stream.read(reinterpret_cast<char*>(&entry.key.cols), sizeof entry.key.cols);
+	stream.read(reinterpret_cast<char*>(&entry.key.type), sizeof entry.key.type);
+	if (!stream || memcmp(thisMagic, magic, sizeof magic) || thisVersion != version || !(entry.key == key))
+		return false;
+	entry.teethEllipse = readEllipse(stream);
+	entry.remediedTeethEllipse = readEllipse(stream);
+	entry.teeth = TeethModel(stream);
+	entry.remediedTeeth = TeethModel(stream);
+	entry.designImage = readImage(stream);
+	entry.remediedDesignImage = readImage(stream);
+	return stream && entry.teeth.size() == nZones * nTeethPerZone && entry.remediedTeeth.size() == nZones * nTeethPerZone && entry.designImage.data && entry.remediedDesignImage.data;
+}
+
+void BaseImageCache::save(string const& fileName, Entry const& entry) {
+	auto const& tmpFileName = fileName + '.' + to_string(random_device()()) + ".tmp";
+	ofstream stream(tmpFileName, ios::binary | ios::trunc);
+	stream.write(magic, sizeof magic);
+	stream.write(reinterpret_cast<char const*>(&version), sizeof version);
+	stream.write(reinterpret_cast<char const*>(&entry.key.hash), sizeof entry.key.hash);
+	stream.write(reinterpret_cast<char const*>(&entry.key.checkHash), sizeof entry.key.checkHash);
+	stream.write(reinterpret_cast<char const*>(&entry.key.rows), sizeof entry.key.rows);
+	stream.write(reinterpret_cast<char const*>(&entry.key.cols), sizeof entry.key.cols);
+	stream.write(reinterpret_cast<char const*>(&entry.key.type), sizeof entry.key.type);
+	writeEllipse(stream, entry.teethEllipse);
+	writeEllipse(stream, entry.remediedTeethEllipse);
+	entry.teeth.write(stream);
+	entry.remediedTeeth.write(stream);
+	writeImage(stream, entry.designImage);
+	writeImage(stream, entry.remediedDesignImage);
+	stream.close();
+	if (stream.fail() || rename(tmpFileName.c_str(), fileName.c_str()))
+		remove(tmpFileName.c_str());
+}
+
+void BaseImageCache::insert(Entry const& entry) {
+	auto const& hash = entry.key.hash;
+	auto const& tmpIt = entries_.find(hash);
+	if (tmpIt != entries_.end()) {
+		tmpIt->second = entry;
+		return;
+	}
+	if (keys_.size() == capacity) {
+		entries_.erase(keys_.front());
+		keys_.pop_front();
+	}
+	keys_.push_back(hash);
+	entries_[hash] = entry;
+}
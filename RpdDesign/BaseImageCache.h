@@ -0,0 +1,41 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "TeethModel.h"
+
+class BaseImageCache {
+public:
+	static void analyze(Mat const& base, DesignContext& context, TeethModel& remediedTeeth, Mat (&remediedDesignImages)[2], TeethModel* const& teeth = nullptr, Mat (*const& designImages)[2] = nullptr, Mat* const& baseImage = nullptr);
+	static void clear();
+	static void setDirectory(string const& directory);
+	static size_t getHits();
+	static size_t getMisses();
+	static size_t const capacity = 16;
+private:
+	struct Key {
+		uint64_t hash, checkHash;
+		int32_t rows, cols, type;
+		bool operator==(Key const& key) const;
+	};
+
+	struct Entry {
+		Key key;
+		Mat designImage, remediedDesignImage;
+		RotatedRect teethEllipse, remediedTeethEllipse;
+		TeethModel teeth, remediedTeeth;
+	};
+
+	static Key computeKey(Mat const& image);
+	static string getFileName(Key const& key);
+	static bool load(string const& fileName, Key const& key, Entry& entry);
+	static void save(string const& fileName, Entry const& entry);
+	static void insert(Entry const& entry);
+	static size_t hits_, misses_;
+	static string directory_;
+	static deque<uint64_t> keys_;
+	static unordered_map<uint64_t, Entry> entries_;
+	static mutex mutex_;
+};
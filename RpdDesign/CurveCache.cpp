@@ -0,0 +1,54 @@
+﻿#include <cstring>
+#include <opencv2/core.hpp>
+
+#include "CurveCache.h"
+#include "TeethModel.h"
+
+CurveCache::CurveCache(bool const& isEnabled) : isEnabled_(isEnabled) {}
+
+vector<uint32_t> CurveCache::computeKey(vector<Rpd::Position> const& positions, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, float const& sumOfRadii, int const& nTeeth) {
+	auto const& toWord = [](float const& value) {
+		uint32_t word;
+		memcpy(&word, &value, sizeof word);
+		return word;
+	};
+	vector<uint32_t> key;
+	key.reserve(positions.size() * 2 + distanceScales.size() + 5);
+	for (auto position = positions.begin(); position < positions.end(); ++position) {
+		key.push_back(position->zone);
+		key.push_back(position->ordinal);
+	}
+	for (auto distanceScale = distanceScales.begin(); distanceScale < distanceScales.end(); ++distanceScale)
+		key.push_back(toWord(*distanceScale));
+	key.push_back(keepStartEndPoints[0] | keepStartEndPoints[1] << 1 | considerAnchorDisplacements[0] << 2 | considerAnchorDisplacements[1] << 3 | considerDistalPoints << 4 | positions.size() << 5);
+	key.push_back(toWord(sumOfRadii));
+	key.push_back(nTeeth);
+	return key;
+}
+
+shared_ptr<CurveCache::StringCurves const> CurveCache::find(TeethModel const& teeth, vector<uint32_t> const& key) {
+	if (!isEnabled_)
+		return nullptr;
+	auto const& tmpIt = entries_.find(key);
+	auto isHit = tmpIt != entries_.end();
+	for (auto flag = 0; flag <= SINGLE_SIDED_DENTURE_BASE && isHit; ++flag)
+		isHit = teeth.peekFlags(static_cast<ToothFlag>(flag), tmpIt->second->readFlags[flag]) == tmpIt->second->flags[flag];
+	++(isHit ? hits_ : misses_);
+	if (isHit)
+		for (auto flag = 0; flag <= SINGLE_SIDED_DENTURE_BASE; ++flag)
+			teeth.addReadFlags(static_cast<ToothFlag>(flag), tmpIt->second->readFlags[flag]);
+	return isHit ? tmpIt->second : nullptr;
+}
+
+void CurveCache::insert(vector<uint32_t> const& key, shared_ptr<StringCurves const> const& stringCurves) {
+	if (isEnabled_)
+		entries_[key] = stringCurves;
+}
+
+void CurveCache::clear() { entries_.clear(); }
+
+bool const& CurveCache::isEnabled() const { return isEnabled_; }
+
+size_t const& CurveCache::getHits() const { return hits_; }
+
+size_t const& CurveCache::getMisses() const { return misses_; }
@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include "Rpd.h"
+
+class TeethModel;
+
+class CurveCache {
+public:
+	struct StringCurves {
+		vector<vector<Point>> curves;
+		vector<Point> distalPoints = vector<Point>(2);
+		bool hasDistalPoints[2]{};
+		float sumOfRadii = 0;
+		int nTeeth = 0;
+		uint32_t flags[SINGLE_SIDED_DENTURE_BASE + 1]{}, readFlags[SINGLE_SIDED_DENTURE_BASE + 1]{};
+	};
+
+	explicit CurveCache(bool const& isEnabled = true);
+	static vector<uint32_t> computeKey(vector<Rpd::Position> const& positions, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, float const& sumOfRadii, int const& nTeeth);
+	shared_ptr<StringCurves const> find(TeethModel const& teeth, vector<uint32_t> const& key);
+	void insert(vector<uint32_t> const& key, shared_ptr<StringCurves const> const& stringCurves);
+	void clear();
+	bool const& isEnabled() const;
+	size_t const& getHits() const;
+	size_t const& getMisses() const;
+private:
+	bool isEnabled_;
+	size_t hits_ = 0, misses_ = 0;
+	map<vector<uint32_t>, shared_ptr<StringCurves const>> entries_;
+};
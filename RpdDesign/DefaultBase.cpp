@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <cstring>
+#include <opencv2/core/mat.hpp>
+
+#include "DefaultBase.h"
+#include "TeethModel.h"
+
+namespace {
+#include "DefaultBaseData.inc"
+}
+
+void DefaultBase::load(DesignContext& context, TeethModel& remediedTeeth, Mat (&remediedDesignImages)[2], TeethModel* const& teeth, Mat (*const& designImages)[2]) {
+	context.teethEllipse = RotatedRect(Point2f(ellipses[0][0], ellipses[0][1]), Size2f(ellipses[0][2], ellipses[0][3]), ellipses[0][4]);
+	context.remediedTeethEllipse = RotatedRect(Point2f(ellipses[1][0], ellipses[1][1]), Size2f(ellipses[1][2], ellipses[1][3]), ellipses[1][4]);
+	loadTeeth(1, remediedTeeth);
+	remediedDesignImages[0] = loadOutline(1, Size(imageWidth, remediedImageHeight));
+	if (teeth)
+		loadTeeth(0, *teeth);
+	if (designImages)
+		(*designImages)[0] = loadOutline(0, Size(imageWidth, imageHeight));
+}
+
+void DefaultBase::loadTeeth(int const& set, TeethModel& teeth) {
+	auto const& nTeeth = nZones * nTeethPerZone;
+	vector<Point> points;
+	vector<int> zones, thisContourOffsets;
+	vector<float> radii;
+	vector<Point2f> centroids, normalDirections;
+	for (auto i = contourOffsets[set][0]; i < contourOffsets[set][nTeeth]; ++i)
+		points.push_back(Point(contourPoints[i][0], contourPoints[i][1]));
+	for (auto no = 0; no < nTeeth; ++no) {
+		auto const& scalars = toothScalars[set][no];
+		zones.push_back(no / nTeethPerZone);
+		radii.push_back(scalars[0]);
+		centroids.push_back(Point2f(scalars[1], scalars[2]));
+		normalDirections.push_back(Point2f(scalars[3], scalars[4]));
+	}
+	for (auto no = 0; no <= nTeeth; ++no)
+		thisContourOffsets.push_back(contourOffsets[set][no] - contourOffsets[set][0]);
+	teeth = TeethModel(points, thisContourOffsets, zones, radii, centroids, normalDirections, vector<int>(anglePointIndices[set][0], anglePointIndices[set][nTeeth]));
+}
+
+Mat DefaultBase::loadOutline(int const& set, Size const& size) {
+	Mat outline(size, CV_8U);
+	auto data = outline.data;
+	for (auto i = outlineRunOffsets[set]; i < outlineRunOffsets[set + 1]; ++i) {
+		memset(data, outlineRuns[i][0], outlineRuns[i][1]);
+		data += outlineRuns[i][1];
+	}
+	return outline;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "GlobalVariables.h"
+
+class TeethModel;
+
+class DefaultBase {
+public:
+	static void load(DesignContext& context, TeethModel& remediedTeeth, Mat (&remediedDesignImages)[2], TeethModel* const& teeth = nullptr, Mat (*const& designImages)[2] = nullptr);
+private:
+	static void loadTeeth(int const& set, TeethModel& teeth);
+	static Mat loadOutline(int const& set, Size const& size);
+};
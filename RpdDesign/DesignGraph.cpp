@@ -0,0 +1,84 @@
+﻿#include <opencv2/core.hpp>
+
+#include "DesignGraph.h"
+#include "RpdStore.h"
+#include "TeethModel.h"
+
+DisplayList const& DesignGraph::getDirtyComponents() const { return dirtyComponents_; }
+
+bool DesignGraph::isIncremental() const { return isIncremental_; }
+
+void DesignGraph::beginUpdate(DesignContext const& context, RpdStore const& rpds, bool const& justLoadedImage, bool const& justLoadedRpds) {
+	isIncremental_ = isBuilt_ && !justLoadedImage && context.isRemedied == isRemedied_ && equal(std::begin(isEighthUsed_), std::end(isEighthUsed_), context.isEighthUsed);
+	isRemedied_ = context.isRemedied;
+	copy(std::begin(context.isEighthUsed), std::end(context.isEighthUsed), isEighthUsed_);
+	lastNodes_.swap(nodes_);
+	for (auto lastNode = lastNodes_.begin(); lastNode < lastNodes_.end(); ++lastNode)
+		lastNode->isReused = false;
+	nodes_.assign(rpds.size(), Node());
+	auto const& allRpds = rpds.getRpds();
+	for (auto rpd = allRpds.begin(); rpd < allRpds.end(); ++rpd) {
+		auto& node = nodes_[rpd - allRpds.begin()];
+		node.individual = (*rpd)->getIndividual();
+		node.hasSetup = justLoadedRpds;
+	}
+	if (!justLoadedRpds && lastNodes_.size() == nodes_.size())
+		for (auto node = nodes_.begin(); node < nodes_.end(); ++node) {
+			auto const& lastNode = lastNodes_[node - nodes_.begin()];
+			node->hasSetup = lastNode.hasSetup;
+			copy(std::begin(lastNode.setupFlags), std::end(lastNode.setupFlags), node->setupFlags);
+			copy(std::begin(lastNode.setupReadFlags), std::end(lastNode.setupReadFlags), node->setupReadFlags);
+		}
+}
+
+void DesignGraph::registerSetup(TeethModel const& teeth, int const& no) {
+	auto& node = nodes_[no];
+	registerFlags(teeth, node.setupFlags, node.setupReadFlags);
+}
+
+bool DesignGraph::reuseComponent(TeethModel const& teeth, int const& no, DisplayList const& lastDisplayList, DisplayList& displayList) {
+	auto& node = nodes_[no];
+	if (!isIncremental_ || !node.individual || !node.hasSetup)
+		return false;
+	for (auto lastNode = lastNodes_.begin(); lastNode < lastNodes_.end(); ++lastNode) {
+		if (lastNode->isReused || !lastNode->individual || !lastNode->hasSetup || *lastNode->individual != *node.individual || !equal(std::begin(lastNode->setupFlags), std::end(lastNode->setupFlags), node.setupFlags) || !equal(std::begin(lastNode->setupReadFlags), std::end(lastNode->setupReadFlags), node.setupReadFlags))
+			continue;
+		auto isReusable = true;
+		for (auto flag = 0; flag <= SINGLE_SIDED_DENTURE_BASE && isReusable; ++flag)
+			isReusable = teeth.getFlags(static_cast<ToothFlag>(flag), lastNode->drawReadFlags[flag]) == lastNode->drawFlags[flag];
+		if (isReusable) {
+			lastNode->isReused = node.isReused = true;
+			copy(std::begin(lastNode->drawFlags), std::end(lastNode->drawFlags), node.drawFlags);
+			copy(std::begin(lastNode->drawReadFlags), std::end(lastNode->drawReadFlags), node.drawReadFlags);
+			displayList.appendComponent(lastDisplayList, lastNode - lastNodes_.begin() + 1);
+			return true;
+		}
+	}
+	return false;
+}
+
+void DesignGraph::registerDraw(TeethModel const& teeth, int const& no) {
+	auto& node = nodes_[no];
+	registerFlags(teeth, node.drawFlags, node.drawReadFlags);
+}
+
+void DesignGraph::endUpdate(DisplayList const& lastDisplayList, DisplayList const& displayList) {
+	dirtyComponents_.clear();
+	if (isIncremental_) {
+		for (auto lastNode = lastNodes_.begin(); lastNode < lastNodes_.end(); ++lastNode)
+			if (!lastNode->isReused)
+				dirtyComponents_.appendComponent(lastDisplayList, lastNode - lastNodes_.begin() + 1);
+		for (auto node = nodes_.begin(); node < nodes_.end(); ++node)
+			if (!node->isReused)
+				dirtyComponents_.appendComponent(displayList, node - nodes_.begin() + 1);
+	}
+	lastNodes_.clear();
+	isBuilt_ = true;
+}
+
+void DesignGraph::registerFlags(TeethModel const& teeth, uint32_t (&flags)[SINGLE_SIDED_DENTURE_BASE + 1], uint32_t (&readFlags)[SINGLE_SIDED_DENTURE_BASE + 1]) {
+	for (auto flag = 0; flag <= SINGLE_SIDED_DENTURE_BASE; ++flag) {
+		readFlags[flag] = teeth.getReadFlags(static_cast<ToothFlag>(flag));
+		flags[flag] = teeth.getFlags(static_cast<ToothFlag>(flag), readFlags[flag]);
+	}
+}
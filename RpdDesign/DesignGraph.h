@@ -0,0 +1,34 @@
+﻿#pragma once
+
+#include <memory>
+
+#include "DisplayList.h"
+
+class RpdStore;
+
+class TeethModel;
+
+struct Individual;
+
+class DesignGraph {
+public:
+	DisplayList const& getDirtyComponents() const;
+	bool isIncremental() const;
+	void beginUpdate(DesignContext const& context, RpdStore const& rpds, bool const& justLoadedImage, bool const& justLoadedRpds);
+	void registerSetup(TeethModel const& teeth, int const& no);
+	bool reuseComponent(TeethModel const& teeth, int const& no, DisplayList const& lastDisplayList, DisplayList& displayList);
+	void registerDraw(TeethModel const& teeth, int const& no);
+	void endUpdate(DisplayList const& lastDisplayList, DisplayList const& displayList);
+private:
+	struct Node {
+		shared_ptr<Individual const> individual;
+		bool hasSetup, isReused;
+		uint32_t drawFlags[SINGLE_SIDED_DENTURE_BASE + 1], drawReadFlags[SINGLE_SIDED_DENTURE_BASE + 1], setupFlags[SINGLE_SIDED_DENTURE_BASE + 1], setupReadFlags[SINGLE_SIDED_DENTURE_BASE + 1];
+	};
+
+	static void registerFlags(TeethModel const& teeth, uint32_t (&flags)[SINGLE_SIDED_DENTURE_BASE + 1], uint32_t (&readFlags)[SINGLE_SIDED_DENTURE_BASE + 1]);
+	bool isBuilt_ = false, isIncremental_ = false, isRemedied_ = false;
+	bool isEighthUsed_[nZones]{};
+	DisplayList dirtyComponents_;
+	vector<Node> lastNodes_, nodes_;
+};
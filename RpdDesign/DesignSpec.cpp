@@ -0,0 +1,81 @@
+#include <cstring>
+#include <fstream>
+#include <opencv2/core/mat.hpp>
+
+#include "DesignSpec.h"
+#include "MappedFile.h"
+
+char const DesignSpec::magic_[4]{'R', 'P', 'D', 'S'};
+
+bool DesignSpec::read(string const& fileName, vector<Individual>& individuals) {
+	MappedFile const file(fileName);
+	if (!file.isOpen() || file.getSize() < sizeof(Header))
+		return false;
+	auto const& header = *reinterpret_cast<Header const*>(file.getData());
+	if (memcmp(header.magic, magic_, sizeof magic_) || header.version != version || header.headerSize != sizeof(Header) || file.getSize() != sizeof(Header) + static_cast<uint64_t>(header.nRecords) * sizeof(Record) + static_cast<uint64_t>(header.nPositions) * sizeof(PackedPosition))
+		return false;
+	auto const& records = reinterpret_cast<Record const*>(file.getData() + sizeof(Header));
+	auto const& positions = reinterpret_cast<PackedPosition const*>(records + header.nRecords);
+	vector<Individual> thisIndividuals;
+	thisIndividuals.reserve(header.nRecords);
+	for (auto record = records; record < records + header.nRecords; ++record) {
+		if (record->rpdClass > WW_CLASP || record->firstPosition > header.nPositions || header.nPositions - record->firstPosition < static_cast<uint32_t>(record->nPositions) + record->nLingualConfrontations)
+			return false;
+		thisIndividuals.push_back(Individual(static_cast<RpdClass>(record->rpdClass)));
+		auto& individual = thisIndividuals.back();
+		individual.claspMaterial = record->claspMaterial;
+		individual.claspTipDirection = record->claspTipDirection;
+		individual.claspTipSide = record->claspTipSide;
+		individual.enableBuccalArm = record->enableBuccalArm;
+		individual.enableLingualArm = record->enableLingualArm;
+		individual.enableRest = record->enableRest;
+		individual.isMissing = record->isMissing;
+		individual.restMesialOrDistal = record->restMesialOrDistal;
+		auto position = positions + record->firstPosition;
+		for (auto i = 0; i < record->nPositions + record->nLingualConfrontations; ++i, ++position) {
+			if (position->zone < 0 || position->zone >= nZones || position->ordinal < 0 || position->ordinal >= nTeethPerZone)
+				return false;
+			(i < record->nPositions ? individual.positions : individual.lingualConfrontations).push_back(Rpd::Position(position->zone, position->ordinal));
+		}
+	}
+	individuals = thisIndividuals;
+	return true;
+}
+
+bool DesignSpec::write(string const& fileName, vector<Individual> const& individuals) {
+	vector<Record> records;
+	vector<PackedPosition> positions;
+	for (auto individual = individuals.begin(); individual < individuals.end(); ++individual) {
+		if (individual->positions.size() > UINT8_MAX || individual->lingualConfrontations.size() > UINT8_MAX)
+			return false;
+		Record record{};
+		record.rpdClass = static_cast<uint8_t>(individual->rpdClass);
+		record.claspMaterial = static_cast<int8_t>(individual->claspMaterial);
+		record.claspTipDirection = static_cast<int8_t>(individual->claspTipDirection);
+		record.claspTipSide = static_cast<int8_t>(individual->claspTipSide);
+		record.enableBuccalArm = static_cast<int8_t>(individual->enableBuccalArm);
+		record.enableLingualArm = static_cast<int8_t>(individual->enableLingualArm);
+		record.enableRest = static_cast<int8_t>(individual->enableRest);
+		record.isMissing = static_cast<int8_t>(individual->isMissing);
+		record.restMesialOrDistal = static_cast<int8_t>(individual->restMesialOrDistal);
+		record.nPositions = static_cast<uint8_t>(individual->positions.size());
+		record.nLingualConfrontations = static_cast<uint8_t>(individual->lingualConfrontations.size());
+		record.firstPosition = static_cast<uint32_t>(positions.size());
+		records.push_back(record);
+		for (auto position = individual->positions.begin(); position < individual->positions.end(); ++position)
+			positions.push_back(PackedPosition{static_cast<int8_t>(position->zone), static_cast<int8_t>(position->ordinal)});
+		for (auto position = individual->lingualConfrontations.begin(); position < individual->lingualConfrontations.end(); ++position)
+			positions.push_back(PackedPosition{static_cast<int8_t>(position->zone), static_cast<int8_t>(position->ordinal)});
+	}
+	Header header{};
+	memcpy(header.magic, magic_, sizeof magic_);
+	header.version = version;
+	header.headerSize = sizeof(Header);
+	header.nRecords = static_cast<uint32_t>(records.size());
+	header.nPositions = static_cast<uint32_t>(positions.size());
+	ofstream file(fileName, ios::binary | ios::trunc);
+	file.write(reinterpret_cast<char const*>(&header), sizeof header);
+	file.write(reinterpret_cast<char const*>(records.data()), records.size() * sizeof(Record));
+	file.write(reinterpret_cast<char const*>(positions.data()), positions.size() * sizeof(PackedPosition));
+	return file.good();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Rpd.h"
+
+class DesignSpec {
+public:
+	static bool read(string const& fileName, vector<Individual>& individuals);
+	static bool write(string const& fileName, vector<Individual> const& individuals);
+	static uint16_t const version = 1;
+private:
+	struct Header {
+		char magic[4];
+		uint16_t version, headerSize;
+		uint32_t nRecords, nPositions;
+	};
+
+	struct Record {
+		uint8_t rpdClass;
+		int8_t claspMaterial, claspTipDirection, claspTipSide, enableBuccalArm, enableLingualArm, enableRest, isMissing, restMesialOrDistal;
+		uint8_t nPositions, nLingualConfrontations, reserved;
+		uint32_t firstPosition;
+	};
+
+	struct PackedPosition {
+		int8_t zone, ordinal;
+	};
+
+	static_assert(sizeof(Header) == 16 && sizeof(Record) == 16 && sizeof(PackedPosition) == 2, "Unexpected design spec layout");
+	static char const magic_[4];
+};
@@ -0,0 +1,309 @@
+﻿#include <opencv2/imgproc.hpp>
+#include <ostream>
+#include <sstream>
+
+#include "DisplayList.h"
+#include "ParallelTask.h"
+#include "Utilities.h"
+
+void DisplayList::addArc(Point const& center, Size const& axes, float const& inclination, float const& startAngle, float const& endAngle, int const& thicknessLevel) { addPrimitive(ARC, {center, Point(axes.width, axes.height)}, false, 0, thicknessLevel, inclination, startAngle, endAngle); }
+
+void DisplayList::addFill(vector<Point> const& polygon, uchar const& value) { addPrimitive(FILL, polygon, true, value); }
+
+void DisplayList::addPolyline(vector<Point> const& curve, bool const& isClosed, int const& thicknessLevel) { addPrimitive(POLYLINE, curve, isClosed, 0, thicknessLevel); }
+
+void DisplayList::addShade(vector<Point> const& polygon, uchar const& value) { addPrimitive(SHADE, polygon, true, value); }
+
+void DisplayList::mergeShades() { addPrimitive(MERGE_SHADES, {}); }
+
+void DisplayList::appendComponent(DisplayList const& displayList, int const& component) {
+	int startPrimitive, endPrimitive;
+	displayList.computeComponentRange(component, startPrimitive, endPrimitive);
+	beginComponent();
+	for (auto primitive = displayList.primitives_.begin() + startPrimitive; primitive < displayList.primitives_.begin() + endPrimitive; ++primitive) {
+		primitives_.push_back(*primitive);
+		primitives_.back().start = points_.size();
+		points_.insert(points_.end(), displayList.points_.begin() + primitive->start, displayList.points_.begin() + primitive->end);
+		primitives_.back().end = points_.size();
+	}
+}
+
+void DisplayList::beginComponent() { componentOffsets_.push_back(primitives_.size()); }
+
+void DisplayList::clear() {
+	componentOffsets_.clear();
+	points_.clear();
+	primitives_.clear();
+}
+
+int DisplayList::getNComponents() const { return componentOffsets_.size(); }
+
+Rect DisplayList::computeComponentRect(Size const& imageSize, int const& component, float const& scale, Point2f const& offset) const {
+	int startPrimitive, endPrimitive;
+	computeComponentRange(component, startPrimitive, endPrimitive);
+	return computeComponentRect(imageSize, startPrimitive, endPrimitive, scale, offset);
+}
+
+void DisplayList::computeShadeRects(Size const& imageSize, vector<Rect>& shadeRects, float const& scale, Point2f const& offset) const {
+	shadeRects.clear();
+	for (auto primitive = primitives_.begin(); primitive < primitives_.end(); ++primitive)
+		if (primitive->type == SHADE && (primitive == primitives_.begin() || (primitive - 1)->type != SHADE))
+			shadeRects.push_back(computeShadeRect(Rect(Point(), imageSize), primitive - primitives_.begin(), scale, offset));
+}
+
+void DisplayList::rasterize(Mat const& image, float const& scale, Point2f const& offset, bool const& shouldClipShades, bool const& isParallel) const { composite(image, Rect(Point(), image.size()), scale, offset, shouldClipShades, isParallel); }
+
+void DisplayList::rasterize(Mat const& image, int const& component, float const& scale, Point2f const& offset) const {
+	int startPrimitive, endPrimitive;
+	computeComponentRange(component, startPrimitive, endPrimitive);
+	rasterize(image, startPrimitive, endPrimitive, scale, offset, Point(), true);
+}
+
+void DisplayList::rasterize(Mat const& image, Rect const& region, bool const& isParallel) const { composite(image, region & Rect(Point(), image.size()), 1, Point2f(), true, isParallel); }
+
+void DisplayList::writePdf(ostream& stream, Size const& size) const {
+	ostringstream content;
+	content << "1 0 0 -1 0 " << size.height << " cm 1 J 1 j 0 G\n";
+	for (auto primitive = primitives_.begin(); primitive < primitives_.end(); ++primitive)
+		if (primitive->type == SHADE) {
+			if (primitive == primitives_.begin() || (primitive - 1)->type != SHADE)
+				content << primitive->value / 255. << " g\n";
+			for (auto point = points_.begin() + primitive->start; point < points_.begin() + primitive->end; ++point)
+				content << point->x << ' ' << point->y << (point == points_.begin() + primitive->start ? " m\n" : " l\n");
+			content << "h\n";
+		}
+		else if (primitive->type == MERGE_SHADES && primitive != primitives_.begin() && (primitive - 1)->type == SHADE)
+			content << "f*\n";
+	vector<Point2f> controlPoints;
+	for (auto primitive = primitives_.begin(); primitive < primitives_.end(); ++primitive) {
+		if (primitive->type == MERGE_SHADES || primitive->type == SHADE)
+			continue;
+		if (primitive->type == FILL)
+			content << primitive->value / 255. << " g\n";
+		else
+			content << lineThicknessOfLevel[primitive->thicknessLevel] << " w\n";
+		if (primitive->type == ARC) {
+			computeArc(*primitive, controlPoints);
+			content << controlPoints[0].x << ' ' << controlPoints[0].y << " m\n";
+			for (auto point = controlPoints.begin() + 1; point < controlPoints.end(); point += 3)
+				content << point[0].x << ' ' << point[0].y << ' ' << point[1].x << ' ' << point[1].y << ' ' << point[2].x << ' ' << point[2].y << " c\n";
+			content << "S\n";
+		}
+		else {
+			for (auto point = points_.begin() + primitive->start; point < points_.begin() + primitive->end; ++point)
+				content << point->x << ' ' << point->y << (point == points_.begin() + primitive->start ? " m\n" : " l\n");
+			content << (primitive->type == FILL ? "h f\n" : primitive->isClosed ? "s\n" : "S\n");
+		}
+	}
+	auto const& contentString = content.str();
+	ostringstream document;
+	vector<streamoff> offsets;
+	document << "%PDF-1.4\n";
+	offsets.push_back(document.tellp());
+	document << "1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n";
+	offsets.push_back(document.tellp());
+	document << "2 0 obj\n<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n";
+	offsets.push_back(document.tellp());
+	document << "3 0 obj\n<< /Type /Page /Parent 2 0 R /MediaBox [0 0 " << size.width << ' ' << size.height << "] /Contents 4 0 R >>\nendobj\n";
+	offsets.push_back(document.tellp());
+	document << "4 0 obj\n<< /Length " << contentString.size() << " >>\nstream\n" << contentString << "endstream\nendobj\n";
+	auto const& xrefOffset = document.tellp();
+	document << "xref\n0 " << offsets.size() + 1 << "\n0000000000 65535 f \n";
+	for (auto offset = offsets.begin(); offset < offsets.end(); ++offset) {
+		document.width(10);
+		document.fill('0');
+		document << *offset << " 00000 n \n";
+	}
+	document << "trailer\n<< /Size " << offsets.size() + 1 << " /Root 1 0 R >>\nstartxref\n" << xrefOffset << "\n%%EOF\n";
+	stream << document.str();
+}
+
+void DisplayList::writeSvg(ostream& stream, Size const& size) const {
+	stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << size.width << "\" height=\"" << size.height << "\" viewBox=\"0 0 " << size.width << ' ' << size.height << "\">\n<rect width=\"100%\" height=\"100%\" fill=\"#fff\"/>\n";
+	for (auto primitive = primitives_.begin(); primitive < primitives_.end(); ++primitive)
+		if (primitive->type == SHADE) {
+			if (primitive == primitives_.begin() || (primitive - 1)->type != SHADE)
+				stream << "<path fill=\"rgb(" << +primitive->value << ',' << +primitive->value << ',' << +primitive->value << ")\" fill-rule=\"evenodd\" d=\"";
+			for (auto point = points_.begin() + primitive->start; point < points_.begin() + primitive->end; ++point)
+				stream << (point == points_.begin() + primitive->start ? 'M' : ' ') << point->x << ' ' << point->y;
+			stream << 'Z';
+		}
+		else if (primitive->type == MERGE_SHADES && primitive != primitives_.begin() && (primitive - 1)->type == SHADE)
+			stream << "\"/>\n";
+	stream << "<g fill=\"none\" stroke=\"#000\" stroke-linecap=\"round\" stroke-linejoin=\"round\">\n";
+	vector<Point2f> controlPoints;
+	for (auto primitive = primitives_.begin(); primitive < primitives_.end(); ++primitive) {
+		if (primitive->type == MERGE_SHADES || primitive->type == SHADE)
+			continue;
+		if (primitive->type == FILL)
+			stream << "<path fill=\"rgb(" << +primitive->value << ',' << +primitive->value << ',' << +primitive->value << ")\" stroke=\"none\" d=\"";
+		else
+			stream << "<path stroke-width=\"" << lineThicknessOfLevel[primitive->thicknessLevel] << "\" d=\"";
+		if (primitive->type == ARC) {
+			computeArc(*primitive, controlPoints);
+			stream << 'M' << controlPoints[0].x << ' ' << controlPoints[0].y << 'C';
+			for (auto point = controlPoints.begin() + 1; point < controlPoints.end(); ++point)
+				stream << (point == controlPoints.begin() + 1 ? "" : " ") << point->x << ' ' << point->y;
+		}
+		else {
+			for (auto point = points_.begin() + primitive->start; point < points_.begin() + primitive->end; ++point)
+				stream << (point == points_.begin() + primitive->start ? 'M' : ' ') << point->x << ' ' << point->y;
+			if (primitive->isClosed)
+				stream << 'Z';
+		}
+		stream << "\"/>\n";
+	}
+	stream << "</g>\n</svg>\n";
+}
+
+void DisplayList::addPrimitive(PrimitiveType const& type, vector<Point> const& points, bool const& isClosed, uchar const& value, int const& thicknessLevel, float const& inclination, float const& startAngle, float const& endAngle) {
+	auto const& start = static_cast<int>(points_.size());
+	points_.insert(points_.end(), points.begin(), points.end());
+	primitives_.push_back({type, isClosed, value, thicknessLevel, start, static_cast<int>(points_.size()), inclination, startAngle, endAngle});
+}
+
+void DisplayList::composite(Mat const& image, Rect const& region, float const& scale, Point2f const& offset, bool const& shouldClipShades, bool const& isParallel) const {
+	auto offsets = componentOffsets_;
+	if (offsets.empty() || offsets[0])
+		offsets.insert(offsets.begin(), 0);
+	offsets.push_back(primitives_.size());
+	auto const& nComponents = static_cast<int>(offsets.size()) - 1;
+	vector<Rect> componentRects(nComponents);
+	vector<int> levels(nComponents, -1);
+	vector<vector<int>> levelComponents;
+	Rect targetRect;
+	for (auto component = 0; component < nComponents; ++component) {
+		auto& componentRect = componentRects[component];
+		componentRect = computeComponentRect(image.size(), offsets[component], offsets[component + 1], scale, offset);
+		if (!(componentRect & region).area())
+			continue;
+		auto& level = levels[component];
+		level = 0;
+		for (auto lastComponent = 0; lastComponent < component; ++lastComponent)
+			if (levels[lastComponent] >= level && (componentRects[lastComponent] & componentRect).area())
+				level = levels[lastComponent] + 1;
+		if (level == levelComponents.size())
+			levelComponents.push_back(vector<int>());
+		levelComponents[level].push_back(component);
+		targetRect = targetRect.area() ? targetRect | componentRect : componentRect;
+	}
+	if (levelComponents.empty())
+		return;
+	auto const& isClipped = region != Rect(Point(), image.size());
+	auto const& target = isClipped ? image(targetRect).clone() : image;
+	auto const& origin = isClipped ? targetRect.tl() : Point();
+	for (auto components = levelComponents.begin(); components < levelComponents.end(); ++components)
+		ParallelTask::run(Range(0, components->size()), [this, &scale, &offset, &shouldClipShades, &offsets, &components, &target, &origin](Range const& range) {
+			for (auto i = range.start; i < range.end; ++i) {
+				auto const& component = (*components)[i];
+				rasterize(target, offsets[component], offsets[component + 1], scale, offset, origin, shouldClipShades);
+			}
+		}, isParallel && shouldClipShades);
+	if (isClipped) {
+		auto const& rect = region & targetRect;
+		target(rect - origin).copyTo(image(rect));
+	}
+}
+
+void DisplayList::computeArc(Primitive const& primitive, vector<Point2f>& controlPoints) const {
+	Point2f const center = points_[primitive.start];
+	auto const& axes = points_[primitive.start + 1];
+	auto const& inclination = degreeToRadian(primitive.inclination), startAngle = degreeToRadian(primitive.startAngle), endAngle = degreeToRadian(primitive.endAngle);
+	auto const& nSegments = max(static_cast<int>(ceil(abs(endAngle - startAngle) / (CV_PI / 2))), 1);
+	auto const& stepAngle = (endAngle - startAngle) / nSegments;
+	auto const& tangentScale = 4 * tan(stepAngle / 4) / 3;
+	controlPoints.clear();
+	for (auto i = 0; i <= nSegments; ++i) {
+		auto const& angle = startAngle + stepAngle * i;
+		Point2f const point(axes.x * cos(angle), axes.y * sin(angle)), tangent(-axes.x * sin(angle) * tangentScale, axes.y * cos(angle) * tangentScale);
+		if (i)
+			controlPoints.push_back(center + rotate(point - tangent, inclination));
+		controlPoints.push_back(center + rotate(point, inclination));
+		if (i < nSegments)
+			controlPoints.push_back(center + rotate(point + tangent, inclination));
+	}
+	for (auto point = controlPoints.begin(); point < controlPoints.end(); ++point)
+		*point = Point2f(round(point->x * 100) / 100, round(point->y * 100) / 100);
+}
+
+Rect DisplayList::computeComponentRect(Size const& imageSize, int const& startPrimitive, int const& endPrimitive, float const& scale, Point2f const& offset) const {
+	Rect componentRect;
+	for (auto primitive = primitives_.begin() + startPrimitive; primitive < primitives_.begin() + endPrimitive; ++primitive) {
+		if (primitive->type == MERGE_SHADES)
+			continue;
+		Rect boundingRect;
+		auto padding = 2;
+		if (primitive->type == ARC) {
+			auto const& center = points_[primitive->start];
+			auto const& radius = max(points_[primitive->start + 1].x, points_[primitive->start + 1].y);
+			boundingRect = Rect(center - Point(radius, radius), center + Point(radius + 1, radius + 1));
+		}
+		else
+			boundingRect = cv::boundingRect(vector<Point>(points_.begin() + primitive->start, points_.begin() + primitive->end));
+		if (primitive->type == ARC || primitive->type == POLYLINE)
+			padding += max(static_cast<int>(round(lineThicknessOfLevel[primitive->thicknessLevel] * scale)), 1) + 1;
+		auto const& rect = transformRect(boundingRect, padding, scale, offset);
+		componentRect = componentRect.area() ? componentRect | rect : rect;
+	}
+	return componentRect & Rect(Point(), imageSize);
+}
+
+void DisplayList::computeComponentRange(int const& component, int& startPrimitive, int& endPrimitive) const {
+	startPrimitive = componentOffsets_[component];
+	endPrimitive = component + 1 < componentOffsets_.size() ? componentOffsets_[component + 1] : primitives_.size();
+}
+
+Rect DisplayList::computeShadeRect(Rect const& bounds, int const& startPrimitive, float const& scale, Point2f const& offset) const {
+	Rect shadeRect;
+	for (auto primitive = primitives_.begin() + startPrimitive; primitive < primitives_.end() && primitive->type == SHADE; ++primitive) {
+		auto const& rect = transformRect(cv::boundingRect(vector<Point>(points_.begin() + primitive->start, points_.begin() + primitive->end)), 2, scale, offset);
+		shadeRect = shadeRect.area() ? shadeRect | rect : rect;
+	}
+	return shadeRect & bounds;
+}
+
+Rect DisplayList::transformRect(Rect const& rect, int const& padding, float const& scale, Point2f const& offset) const { return Rect(Point(round(rect.x * scale + offset.x) - padding, round(rect.y * scale + offset.y) - padding), Point(round((rect.br().x - 1) * scale + offset.x) + padding + 1, round((rect.br().y - 1) * scale + offset.y) + padding + 1)); }
+
+void DisplayList::rasterize(Mat const& image, int const& startPrimitive, int const& endPrimitive, float const& scale, Point2f const& offset, Point const& origin, bool const& shouldClipShades) const {
+	auto const& isIdentity = scale == 1 && offset == Point2f() && origin == Point();
+	vector<Point> points;
+	Mat shades, shadeBuffer;
+	Rect shadeRect;
+	for (auto primitive = primitives_.begin() + startPrimitive; primitive < primitives_.begin() + endPrimitive; ++primitive) {
+		points.assign(points_.begin() + primitive->start, points_.begin() + primitive->end);
+		if (!isIdentity)
+			for (auto point = points.begin(); point < points.end(); ++point)
+				*point = Point(round(point->x * scale + offset.x), round(point->y * scale + offset.y)) - origin;
+		auto const& thickness = max(static_cast<int>(round(lineThicknessOfLevel[primitive->thicknessLevel] * scale)), 1);
+		switch (primitive->type) {
+			case ARC:
+				ellipse(image, points[0], Size(round(points_[primitive->start + 1].x * scale), round(points_[primitive->start + 1].y * scale)), primitive->inclination, primitive->startAngle, primitive->endAngle, 0, thickness, LINE_AA);
+				break;
+			case FILL:
+				fillPoly(image, vector<vector<Point>>{points}, primitive->value, LINE_AA);
+				break;
+			case MERGE_SHADES:
+				if (shades.data) {
+					auto const& imageRect = image(shadeRect);
+					bitwise_and(shades, imageRect, imageRect);
+					shades.release();
+				}
+				break;
+			case POLYLINE:
+				polylines(image, points, primitive->isClosed, 0, thickness, LINE_AA);
+				break;
+			case SHADE:
+				if (primitive == primitives_.begin() + startPrimitive || (primitive - 1)->type != SHADE) {
+					shadeRect = shouldClipShades ? computeShadeRect(Rect(origin, image.size()), primitive - primitives_.begin(), scale, offset) - origin : Rect(Point(), image.size());
+					if (shadeRect.area()) {
+						if (!shadeBuffer.data)
+							shadeBuffer.create(image.size(), CV_8U);
+						shades = shadeBuffer(Rect(Point(), shadeRect.size()));
+						shades.setTo(255);
+					}
+				}
+				if (shades.data)
+					fillPoly(shades, vector<vector<Point>>{points}, primitive->value, LINE_AA, 0, -shadeRect.tl());
+		}
+	}
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include <iosfwd>
+
+#include "GlobalVariables.h"
+
+class DisplayList {
+public:
+	void addArc(Point const& center, Size const& axes, float const& inclination, float const& startAngle, float const& endAngle, int const& thicknessLevel);
+	void addFill(vector<Point> const& polygon, uchar const& value);
+	void addPolyline(vector<Point> const& curve, bool const& isClosed, int const& thicknessLevel);
+	void addShade(vector<Point> const& polygon, uchar const& value);
+	void mergeShades();
+	void appendComponent(DisplayList const& displayList, int const& component);
+	void beginComponent();
+	void clear();
+	int getNComponents() const;
+	Rect computeComponentRect(Size const& imageSize, int const& component, float const& scale = 1, Point2f const& offset = Point2f()) const;
+	void computeShadeRects(Size const& imageSize, vector<Rect>& shadeRects, float const& scale = 1, Point2f const& offset = Point2f()) const;
+	void rasterize(Mat const& image, float const& scale = 1, Point2f const& offset = Point2f(), bool const& shouldClipShades = true, bool const& isParallel = true) const;
+	void rasterize(Mat const& image, int const& component, float const& scale = 1, Point2f const& offset = Point2f()) const;
+	void rasterize(Mat const& image, Rect const& region, bool const& isParallel = true) const;
+	void writePdf(ostream& stream, Size const& size) const;
+	void writeSvg(ostream& stream, Size const& size) const;
+private:
+	enum PrimitiveType {
+		ARC,
+		FILL,
+		MERGE_SHADES,
+		POLYLINE,
+		SHADE
+	};
+
+	struct Primitive {
+		PrimitiveType type;
+		bool isClosed;
+		uchar value;
+		int thicknessLevel, start, end;
+		float inclination, startAngle, endAngle;
+	};
+
+	void addPrimitive(PrimitiveType const& type, vector<Point> const& points, bool const& isClosed = false, uchar const& value = 0, int const& thicknessLevel = 0, float const& inclination = 0, float const& startAngle = 0, float const& endAngle = 0);
+	void composite(Mat const& image, Rect const& region, float const& scale, Point2f const& offset, bool const& shouldClipShades, bool const& isParallel) const;
+	void computeArc(Primitive const& primitive, vector<Point2f>& controlPoints) const;
+	void computeComponentRange(int const& component, int& startPrimitive, int& endPrimitive) const;
+	Rect computeComponentRect(Size const& imageSize, int const& startPrimitive, int const& endPrimitive, float const& scale, Point2f const& offset) const;
+	Rect computeShadeRect(Rect const& bounds, int const& startPrimitive, float const& scale, Point2f const& offset) const;
+	Rect transformRect(Rect const& rect, int const& padding, float const& scale, Point2f const& offset) const;
+	void rasterize(Mat const& image, int const& startPrimitive, int const& endPrimitive, float const& scale, Point2f const& offset, Point const& origin, bool const& shouldClipShades) const;
+	vector<int> componentOffsets_;
+	vector<Point> points_;
+	vector<Primitive> primitives_;
+};
@@ -0,0 +1,56 @@
+﻿#include <opencv2/core.hpp>
+
+#include "FilletCurve.h"
+#include "Utilities.h"
+
+FilletCurve::FilletCurve(DesignContext const& context, Point const& lastPoint, Point const& cornerPoint, Point const& nextPoint, float const& smoothness) : cornerPoint_(cornerPoint) {
+	Point2f const &v1 = lastPoint - cornerPoint, &v2 = nextPoint - cornerPoint;
+	auto const &l1 = norm(v1), &l2 = norm(v2);
+	if (l1 == 0 || l2 == 0)
+		return;
+	auto const &d1 = v1 / l1, &d2 = v2 / l2;
+	auto const& sinTheta = d1.cross(d2);
+	auto const& cosTheta = d1.dot(d2);
+	auto const& theta = atan2(abs(sinTheta), cosTheta);
+	auto const& sweepAngle = CV_PI - theta;
+	auto const& radius = static_cast<float>(min(l1, l2) * tan(theta / 2) * smoothness);
+	if (sweepAngle < degreeToRadian(2) || radius < 1 || radius > sqrt(context.getTeethEllipse().size.area() * 2))
+		return;
+	isValid_ = true;
+	radius_ = radius;
+	center_ = cornerPoint + roundToPoint(normalize(d1 + d2) * radius / sin(theta / 2));
+	auto const& d = sinTheta < 0 ? d1 : d2;
+	startDirection_ = Point2f(-d.y, d.x);
+	endDirection_ = Point2f(d.y * cosTheta - d.x * abs(sinTheta), -d.x * cosTheta - d.y * abs(sinTheta));
+	nSegments_ = max(static_cast<int>(ceil(sweepAngle / max(2 * acos(1 - arcTolerance / radius_), degreeToRadian(1)))), 1);
+	auto const& stepAngle = sweepAngle / nSegments_;
+	stepRotation_ = Point2f(cos(stepAngle), sin(stepAngle));
+	if (sinTheta > 0) {
+		swap(startDirection_, endDirection_);
+		stepRotation_.y = -stepRotation_.y;
+	}
+}
+
+int FilletCurve::getMaxSize() const { return isValid_ ? nSegments_ + 1 : 1; }
+
+Point FilletCurve::getStartPoint() const { return isValid_ ? center_ + roundToPoint(startDirection_ * radius_) : cornerPoint_; }
+
+Point FilletCurve::getEndPoint() const { return isValid_ ? center_ + roundToPoint(endDirection_ * radius_) : cornerPoint_; }
+
+Point* FilletCurve::getCurve(Point* const& points) const {
+	auto thisPoint = points;
+	*thisPoint = getStartPoint();
+	if (!isValid_)
+		return thisPoint + 1;
+	auto direction = startDirection_;
+	for (auto i = 1; i < nSegments_; ++i) {
+		direction = Point2f(direction.x * stepRotation_.x - direction.y * stepRotation_.y, direction.y * stepRotation_.x + direction.x * stepRotation_.y);
+		auto const& point = center_ + roundToPoint(direction * radius_);
+		if (point != *thisPoint)
+			*++thisPoint = point;
+	}
+	auto const& endPoint = getEndPoint();
+	if (endPoint != *thisPoint)
+		*++thisPoint = endPoint;
+	return thisPoint + 1;
+}
@@ -0,0 +1,20 @@
+﻿#pragma once
+
+using namespace std;
+using namespace cv;
+
+struct DesignContext;
+
+class FilletCurve {
+public:
+	FilletCurve(DesignContext const& context, Point const& lastPoint, Point const& cornerPoint, Point const& nextPoint, float const& smoothness);
+	int getMaxSize() const;
+	Point getStartPoint() const;
+	Point getEndPoint() const;
+	Point* getCurve(Point* const& points) const;
+private:
+	bool isValid_ = false;
+	int nSegments_ = 0, radius_ = 0;
+	Point center_, cornerPoint_;
+	Point2f endDirection_, startDirection_, stepRotation_;
+};
@@ -1,9 +1,5 @@
 ﻿#include <opencv2/core/types.hpp>
 
-using namespace cv;
+#include "GlobalVariables.h"
 
-bool remedyImage;
-
-RotatedRect teethEllipse;
-
-RotatedRect remediedTeethEllipse;
+RotatedRect const& DesignContext::getTeethEllipse() const { return isRemedied ? remediedTeethEllipse : teethEllipse; }
@@ -35,12 +35,33 @@ enum DistanceScaledCurve {
 	OUTER
 };
 
+enum ToothFlag {
+	DISTAL_CLASP_ROOT_OR_REST,
+	DISTAL_LINGUAL_COVERAGE,
+	DISTAL_LINGUAL_REST,
+	DOUBLE_SIDED_DENTURE_BASE,
+	EXPECTED_DISTAL_DENTURE_BASE_ANCHOR,
+	EXPECTED_DISTAL_MAJOR_CONNECTOR_ANCHOR,
+	EXPECTED_MESIAL_DENTURE_BASE_ANCHOR,
+	EXPECTED_MESIAL_MAJOR_CONNECTOR_ANCHOR,
+	LINGUAL_CONFRONTATION,
+	MAJOR_CONNECTOR,
+	MESIAL_CLASP_ROOT_OR_REST,
+	MESIAL_LINGUAL_COVERAGE,
+	MESIAL_LINGUAL_REST,
+	SINGLE_SIDED_DENTURE_BASE
+};
+
+float const arcTolerance = 0.25F;
+
 const float distanceScales[]{1.5F, 1.75F, 1.8F, 2.4F, 2.5F};
 
 const int lineThicknessOfLevel[]{2, 5, 8};
 
 int const nTeethPerZone = 8, nZones = 4;
 
+string const ontPrefix = "http://www.semanticweb.org/msiip/ontologies/CDSSinRPD#";
+
 map<string, RpdClass> const rpdMapping_ = {
 	{"aker_clasp", AKERS_CLASP},
 	{"canine_aker_clasp", CANINE_AKERS_CLASP},
@@ -65,8 +86,11 @@ map<string, RpdClass> const rpdMapping_ = {
 	{"wrought_wire_clasp", WW_CLASP}
 };
 
-extern bool remedyImage;
-
-extern RotatedRect teethEllipse;
+class CurveCache;
 
-extern RotatedRect remediedTeethEllipse;
+struct DesignContext {
+	RotatedRect const& getTeethEllipse() const;
+	bool isRemedied = false, isEighthUsed[nZones]{};
+	RotatedRect teethEllipse, remediedTeethEllipse;
+	CurveCache* curveCache = nullptr;
+};
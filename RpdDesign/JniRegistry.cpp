@@ -0,0 +1,165 @@
+#include <opencv2/core/mat.hpp>
+
+#include "JniRegistry.h"
+#include "Utilities.h"
+
+bool JniRegistry::isMatLoaded_ = false;
+
+bool JniRegistry::isOntologyLoaded_ = false;
+
+JniRegistry JniRegistry::matInstance_;
+
+JniRegistry JniRegistry::ontologyInstance_;
+
+JniRegistry const* JniRegistry::getMat() { return isMatLoaded_ ? &matInstance_ : nullptr; }
+
+JniRegistry const* JniRegistry::getOntology() { return isOntologyLoaded_ ? &ontologyInstance_ : nullptr; }
+
+void JniRegistry::load(JNIEnv* const& env) {
+	loadMat(env);
+	loadOntology(env);
+}
+
+void JniRegistry::unload(JNIEnv* const& env) {
+	unloadMat(env);
+	unloadOntology(env);
+}
+
+bool JniRegistry::loadMat(JNIEnv* const& env) {
+	if (isMatLoaded_)
+		return true;
+	auto const& clsMat = findClass(env, "org/opencv/core/Mat");
+	if (!clsMat)
+		return false;
+	matInstance_.midGetNativeObjAddr = env->GetMethodID(clsMat, "getNativeObjAddr", "()J");
+	matInstance_.midMatInit = env->GetMethodID(clsMat, "<init>", "()V");
+	isMatLoaded_ = !env->ExceptionCheck();
+	if (isMatLoaded_)
+		matInstance_.clsMat = static_cast<jclass>(env->NewGlobalRef(clsMat));
+	else
+		env->ExceptionClear();
+	env->DeleteLocalRef(clsMat);
+	return isMatLoaded_;
+}
+
+bool JniRegistry::loadOntology(JNIEnv* const& env) {
+	if (isOntologyLoaded_)
+		return true;
+	auto const& clsStrExtendedIterator = "org/apache/jena/util/iterator/ExtendedIterator";
+	auto const& clsStrIndividual = "org/apache/jena/ontology/Individual";
+	auto const& clsStrIndividualFlattener = "com/shengjie/IndividualFlattener";
+	auto const& clsStrIterator = "java/util/Iterator";
+	auto const& clsStrObject = "java/lang/Object";
+	auto const& clsStrOntClass = "org/apache/jena/ontology/OntClass";
+	auto const& clsStrOntModel = "org/apache/jena/ontology/OntModel";
+	auto const& clsStrProperty = "org/apache/jena/rdf/model/Property";
+	auto const& clsStrResource = "org/apache/jena/rdf/model/Resource";
+	auto const& clsStrResourceFactory = "org/apache/jena/rdf/model/ResourceFactory";
+	auto const& clsStrStatement = "org/apache/jena/rdf/model/Statement";
+	auto const& clsStrStmtIterator = "org/apache/jena/rdf/model/StmtIterator";
+	auto const& clsStrString = "java/lang/String";
+	auto const& clsIndividual = findClass(env, clsStrIndividual);
+	auto const& clsIterator = findClass(env, clsStrIterator);
+	auto const& clsOntModel = findClass(env, clsStrOntModel);
+	auto const& clsResource = findClass(env, clsStrResource);
+	auto const& clsResourceFactory = findClass(env, clsStrResourceFactory);
+	auto const& clsStatement = findClass(env, clsStrStatement);
+	auto const& clsIndividualFlattener = findClass(env, clsStrIndividualFlattener);
+	auto const& clsString = findClass(env, clsStrString);
+	auto const& isValid = clsIndividual && clsIterator && clsOntModel && clsResource && clsResourceFactory && clsStatement && clsString;
+	if (isValid) {
+		ontologyInstance_.clsIndividual = static_cast<jclass>(env->NewGlobalRef(clsIndividual));
+		ontologyInstance_.clsIterator = static_cast<jclass>(env->NewGlobalRef(clsIterator));
+		ontologyInstance_.clsOntModel = static_cast<jclass>(env->NewGlobalRef(clsOntModel));
+		ontologyInstance_.clsResource = static_cast<jclass>(env->NewGlobalRef(clsResource));
+		ontologyInstance_.clsStatement = static_cast<jclass>(env->NewGlobalRef(clsStatement));
+		if (clsIndividualFlattener) {
+			ontologyInstance_.midFlatten = env->GetStaticMethodID(clsIndividualFlattener, "flatten", ('(' + getClsSig(clsStrOntModel) + '[' + getClsSig(clsStrString) + ")[[I").c_str());
+			if (ontologyInstance_.midFlatten) {
+				auto const& classNames = env->NewObjectArray(static_cast<jsize>(rpdMapping_.size()), clsString, nullptr);
+				auto i = 0;
+				for (auto it = rpdMapping_.begin(); it != rpdMapping_.end(); ++it) {
+					auto const& tmpStr = env->NewStringUTF(it->first.c_str());
+					env->SetObjectArrayElement(classNames, i++, tmpStr);
+					env->DeleteLocalRef(tmpStr);
+				}
+				ontologyInstance_.clsIndividualFlattener = static_cast<jclass>(env->NewGlobalRef(clsIndividualFlattener));
+				ontologyInstance_.classNames = static_cast<jobjectArray>(env->NewGlobalRef(classNames));
+				env->DeleteLocalRef(classNames);
+			}
+			else
+				env->ExceptionClear();
+		}
+		ontologyInstance_.midGetBoolean = env->GetMethodID(clsStatement, "getBoolean", "()Z");
+		ontologyInstance_.midGetInt = env->GetMethodID(clsStatement, "getInt", "()I");
+		ontologyInstance_.midGetLocalName = env->GetMethodID(clsResource, "getLocalName", ("()" + getClsSig(clsStrString)).c_str());
+		ontologyInstance_.midGetOntClass = env->GetMethodID(clsIndividual, "getOntClass", ("()" + getClsSig(clsStrOntClass)).c_str());
+		ontologyInstance_.midHasNext = env->GetMethodID(clsIterator, "hasNext", "()Z");
+		ontologyInstance_.midListIndividuals = env->GetMethodID(clsOntModel, "listIndividuals", ("()" + getClsSig(clsStrExtendedIterator)).c_str());
+		ontologyInstance_.midListProperties = env->GetMethodID(clsResource, "listProperties", ('(' + getClsSig(clsStrProperty) + ')' + getClsSig(clsStrStmtIterator)).c_str());
+		ontologyInstance_.midNext = env->GetMethodID(clsIterator, "next", ("()" + getClsSig(clsStrObject)).c_str());
+		ontologyInstance_.midResourceGetProperty = env->GetMethodID(clsResource, "getProperty", ('(' + getClsSig(clsStrProperty) + ')' + getClsSig(clsStrStatement)).c_str());
+		ontologyInstance_.midStatementGetProperty = env->GetMethodID(clsStatement, "getProperty", ('(' + getClsSig(clsStrProperty) + ')' + getClsSig(clsStrStatement)).c_str());
+		auto const& midCreateProperty = env->GetStaticMethodID(clsResourceFactory, "createProperty", ('(' + getClsSig(clsStrString) + ')' + getClsSig(clsStrProperty)).c_str());
+		ontologyInstance_.dpClaspMaterial = createProperty(env, clsResourceFactory, midCreateProperty, "clasp_material");
+		ontologyInstance_.dpClaspTipDirection = createProperty(env, clsResourceFactory, midCreateProperty, "clasp_tip_direction");
+		ontologyInstance_.dpClaspTipSide = createProperty(env, clsResourceFactory, midCreateProperty, "clasp_tip_side");
+		ontologyInstance_.dpEnableBuccalArm = createProperty(env, clsResourceFactory, midCreateProperty, "enable_buccal_arm");
+		ontologyInstance_.dpEnableLingualArm = createProperty(env, clsResourceFactory, midCreateProperty, "enable_lingual_arm");
+		ontologyInstance_.dpEnableRest = createProperty(env, clsResourceFactory, midCreateProperty, "enable_rest");
+		ontologyInstance_.dpIsMissing = createProperty(env, clsResourceFactory, midCreateProperty, "is_missing");
+		ontologyInstance_.dpLingualConfrontation = createProperty(env, clsResourceFactory, midCreateProperty, "lingual_confrontation");
+		ontologyInstance_.dpRestMesialOrDistal = createProperty(env, clsResourceFactory, midCreateProperty, "rest_mesial_or_distal");
+		ontologyInstance_.dpToothOrdinal = createProperty(env, clsResourceFactory, midCreateProperty, "tooth_ordinal");
+		ontologyInstance_.dpToothZone = createProperty(env, clsResourceFactory, midCreateProperty, "tooth_zone");
+		ontologyInstance_.opComponentPosition = createProperty(env, clsResourceFactory, midCreateProperty, "component_position");
+		isOntologyLoaded_ = !env->ExceptionCheck();
+		if (!isOntologyLoaded_) {
+			env->ExceptionClear();
+			isOntologyLoaded_ = true;
+			unloadOntology(env);
+		}
+	}
+	jclass const classes[]{clsIndividual, clsIndividualFlattener, clsIterator, clsOntModel, clsResource, clsResourceFactory, clsStatement, clsString};
+	for (auto cls = begin(classes); cls < end(classes); ++cls)
+		if (*cls)
+			env->DeleteLocalRef(*cls);
+	return isOntologyLoaded_;
+}
+
+void JniRegistry::unloadMat(JNIEnv* const& env) {
+	if (!isMatLoaded_)
+		return;
+	env->DeleteGlobalRef(matInstance_.clsMat);
+	matInstance_ = JniRegistry();
+	isMatLoaded_ = false;
+}
+
+void JniRegistry::unloadOntology(JNIEnv* const& env) {
+	if (!isOntologyLoaded_)
+		return;
+	jobject const globalRefs[]{ontologyInstance_.classNames, ontologyInstance_.clsIndividual, ontologyInstance_.clsIndividualFlattener, ontologyInstance_.clsIterator, ontologyInstance_.clsOntModel, ontologyInstance_.clsResource, ontologyInstance_.clsStatement, ontologyInstance_.dpClaspMaterial, ontologyInstance_.dpClaspTipDirection, ontologyInstance_.dpClaspTipSide, ontologyInstance_.dpEnableBuccalArm, ontologyInstance_.dpEnableLingualArm, ontologyInstance_.dpEnableRest, ontologyInstance_.dpIsMissing, ontologyInstance_.dpLingualConfrontation, ontologyInstance_.dpRestMesialOrDistal, ontologyInstance_.dpToothOrdinal, ontologyInstance_.dpToothZone, ontologyInstance_.opComponentPosition};
+	for (auto globalRef = begin(globalRefs); globalRef < end(globalRefs); ++globalRef)
+		if (*globalRef)
+			env->DeleteGlobalRef(*globalRef);
+	ontologyInstance_ = JniRegistry();
+	isOntologyLoaded_ = false;
+}
+
+jclass JniRegistry::findClass(JNIEnv* const& env, char const* const& clsStr) {
+	auto const& cls = env->FindClass(clsStr);
+	if (!cls)
+		env->ExceptionClear();
+	return cls;
+}
+
+jobject JniRegistry::createProperty(JNIEnv* const& env, jclass const& clsResourceFactory, jmethodID const& midCreateProperty, char const* const& localName) {
+	auto const& tmpStr = env->NewStringUTF((ontPrefix + localName).c_str());
+	auto const& property = env->CallStaticObjectMethod(clsResourceFactory, midCreateProperty, tmpStr);
+	env->DeleteLocalRef(tmpStr);
+	if (!property)
+		return nullptr;
+	auto const& globalRef = env->NewGlobalRef(property);
+	env->DeleteLocalRef(property);
+	return globalRef;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <jni.h>
+
+enum FlattenedColumn {
+	CLASS_ID,
+	CLASP_MATERIAL,
+	CLASP_TIP_DIRECTION,
+	CLASP_TIP_SIDE,
+	ENABLE_BUCCAL_ARM,
+	ENABLE_LINGUAL_ARM,
+	ENABLE_REST,
+	IS_MISSING,
+	REST_MESIAL_OR_DISTAL,
+	N_POSITIONS,
+	N_LINGUAL_CONFRONTATIONS,
+	POSITIONS,
+	LINGUAL_CONFRONTATIONS,
+	N_FLATTENED_COLUMNS
+};
+
+class JniRegistry {
+public:
+	static JniRegistry const* getMat();
+	static JniRegistry const* getOntology();
+	static void load(JNIEnv* const& env);
+	static void unload(JNIEnv* const& env);
+	jclass clsIndividual, clsIndividualFlattener, clsIterator, clsMat, clsOntModel, clsResource, clsStatement;
+	jmethodID midFlatten, midGetBoolean, midGetInt, midGetLocalName, midGetNativeObjAddr, midGetOntClass, midHasNext, midListIndividuals, midListProperties, midMatInit, midNext, midResourceGetProperty, midStatementGetProperty;
+	jobjectArray classNames;
+	jobject dpClaspMaterial, dpClaspTipDirection, dpClaspTipSide, dpEnableBuccalArm, dpEnableLingualArm, dpEnableRest, dpIsMissing, dpLingualConfrontation, dpRestMesialOrDistal, dpToothOrdinal, dpToothZone, opComponentPosition;
+private:
+	JniRegistry() = default;
+	static jclass findClass(JNIEnv* const& env, char const* const& clsStr);
+	static jobject createProperty(JNIEnv* const& env, jclass const& clsResourceFactory, jmethodID const& midCreateProperty, char const* const& localName);
+	static bool loadMat(JNIEnv* const& env);
+	static bool loadOntology(JNIEnv* const& env);
+	static void unloadMat(JNIEnv* const& env);
+	static void unloadOntology(JNIEnv* const& env);
+	static bool isMatLoaded_, isOntologyLoaded_;
+	static JniRegistry matInstance_, ontologyInstance_;
+};
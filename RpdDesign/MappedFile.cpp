@@ -0,0 +1,64 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+MappedFile::MappedFile(string const& fileName) {
+#ifdef _WIN32
+	auto const& file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+	file_ = file;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || !size.QuadPart)
+		return;
+	mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping_)
+		return;
+	data_ = static_cast<char const*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+	if (data_)
+		size_ = static_cast<size_t>(size.QuadPart);
+#else
+	file_ = open(fileName.c_str(), O_RDONLY);
+	if (file_ < 0)
+		return;
+	struct stat status;
+	if (fstat(file_, &status) || !status.st_size)
+		return;
+	auto const& data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file_, 0);
+	if (data == MAP_FAILED)
+		return;
+	madvise(data, status.st_size, MADV_SEQUENTIAL);
+	data_ = static_cast<char const*>(data);
+	size_ = static_cast<size_t>(status.st_size);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+	if (data_)
+		UnmapViewOfFile(data_);
+	if (mapping_)
+		CloseHandle(mapping_);
+	if (file_)
+		CloseHandle(file_);
+#else
+	if (data_)
+		munmap(const_cast<char*>(data_), size_);
+	if (file_ >= 0)
+		close(file_);
+#endif
+}
+
+bool MappedFile::isOpen() const { return data_ != nullptr; }
+
+char const* MappedFile::getData() const { return data_; }
+
+size_t const& MappedFile::getSize() const { return size_; }
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+class MappedFile {
+public:
+	explicit MappedFile(string const& fileName);
+	MappedFile(MappedFile const&) = delete;
+	~MappedFile();
+	MappedFile& operator=(MappedFile const&) = delete;
+	bool isOpen() const;
+	char const* getData() const;
+	size_t const& getSize() const;
+private:
+	char const* data_ = nullptr;
+	size_t size_ = 0;
+#ifdef _WIN32
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+#else
+	int file_ = -1;
+#endif
+};
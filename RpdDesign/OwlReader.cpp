@@ -0,0 +1,399 @@
+#include <cstring>
+#include <opencv2/core/mat.hpp>
+
+#include "OwlReader.h"
+#include "MappedFile.h"
+
+namespace {
+	string const rdfNamespace = "http://www.w3.org/1999/02/22-rdf-syntax-ns#";
+	string const xmlNamespace = "http://www.w3.org/XML/1998/namespace";
+
+	bool isSpace(char const& c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+	bool isNameEnd(char const& c) { return isSpace(c) || c == '/' || c == '>' || c == '=' || c == '?'; }
+
+	string trim(string const& str) {
+		auto const& first = str.find_first_not_of(" \t\n\r");
+		return first == string::npos ? string() : str.substr(first, str.find_last_not_of(" \t\n\r") - first + 1);
+	}
+
+	void appendUtf8(unsigned long const& codePoint, string& str) {
+		if (codePoint < 0x80)
+			str += static_cast<char>(codePoint);
+		else if (codePoint < 0x800) {
+			str += static_cast<char>(0xC0 | codePoint >> 6);
+			str += static_cast<char>(0x80 | codePoint & 0x3F);
+		}
+		else if (codePoint < 0x10000) {
+			str += static_cast<char>(0xE0 | codePoint >> 12);
+			str += static_cast<char>(0x80 | codePoint >> 6 & 0x3F);
+			str += static_cast<char>(0x80 | codePoint & 0x3F);
+		}
+		else {
+			str += static_cast<char>(0xF0 | codePoint >> 18);
+			str += static_cast<char>(0x80 | codePoint >> 12 & 0x3F);
+			str += static_cast<char>(0x80 | codePoint >> 6 & 0x3F);
+			str += static_cast<char>(0x80 | codePoint & 0x3F);
+		}
+	}
+}
+
+OwlReader::Subject::Subject(string const& iri) : iri(iri) {}
+
+bool OwlReader::read(string const& fileName, vector<Individual>& individuals) {
+	MappedFile const file(fileName);
+	if (!file.isOpen())
+		return false;
+	OwlReader reader(file.getData(), file.getData() + file.getSize());
+	if (!reader.parse())
+		return false;
+	vector<Individual> thisIndividuals;
+	reader.collectIndividuals(thisIndividuals);
+	individuals = thisIndividuals;
+	return true;
+}
+
+OwlReader::OwlReader(char const* const& begin, char const* const& end) : cursor_(begin), end_(end), entities_({{"amp", "&"}, {"apos", "'"}, {"gt", ">"}, {"lt", "<"}, {"quot", "\""}}) {
+	if (end_ - cursor_ >= 3 && !memcmp(cursor_, "\xEF\xBB\xBF", 3))
+		cursor_ += 3;
+}
+
+bool OwlReader::parse() {
+	while (cursor_ < end_)
+		if (*cursor_ == '<') {
+			auto const& remaining = static_cast<size_t>(end_ - cursor_);
+			if (remaining >= 2 && cursor_[1] == '?') {
+				if (!skipPast("?>"))
+					return false;
+			}
+			else if (remaining >= 4 && !memcmp(cursor_, "<!--", 4)) {
+				if (!skipPast("-->"))
+					return false;
+			}
+			else if (remaining >= 9 && !memcmp(cursor_, "<![CDATA[", 9)) {
+				auto const& begin = cursor_ + 9;
+				if (!skipPast("]]>"))
+					return false;
+				if (isCollectingLiteral_)
+					text_.append(begin, cursor_ - 3);
+			}
+			else if (remaining >= 9 && !memcmp(cursor_, "<!DOCTYPE", 9)) {
+				if (!parseDoctype())
+					return false;
+			}
+			else if (remaining >= 2 && cursor_[1] == '/') {
+				if (!parseEndTag())
+					return false;
+			}
+			else if (!parseStartTag())
+				return false;
+		}
+		else {
+			auto const begin = cursor_;
+			auto const& next = static_cast<char const*>(memchr(cursor_, '<', end_ - cursor_));
+			cursor_ = next ? next : end_;
+			characters(begin, cursor_);
+		}
+	return depth_ == 0;
+}
+
+bool OwlReader::skipPast(char const* const& token) {
+	auto const& length = strlen(token);
+	for (auto it = cursor_; it + length <= end_; ++it)
+		if (!memcmp(it, token, length)) {
+			cursor_ = it + length;
+			return true;
+		}
+	return false;
+}
+
+bool OwlReader::parseDoctype() {
+	cursor_ += 9;
+	while (cursor_ < end_ && *cursor_ != '[' && *cursor_ != '>')
+		++cursor_;
+	if (cursor_ < end_ && *cursor_ == '[') {
+		++cursor_;
+		while (cursor_ < end_ && *cursor_ != ']') {
+			if (end_ - cursor_ >= 8 && !memcmp(cursor_, "<!ENTITY", 8)) {
+				cursor_ += 8;
+				while (cursor_ < end_ && isSpace(*cursor_))
+					++cursor_;
+				auto const nameBegin = cursor_;
+				while (cursor_ < end_ && !isSpace(*cursor_))
+					++cursor_;
+				string const name(nameBegin, cursor_);
+				while (cursor_ < end_ && *cursor_ != '"' && *cursor_ != '\'')
+					++cursor_;
+				if (cursor_ == end_)
+					return false;
+				auto const& quote = *cursor_++;
+				auto const valueBegin = cursor_;
+				while (cursor_ < end_ && *cursor_ != quote)
+					++cursor_;
+				if (cursor_ == end_)
+					return false;
+				entities_[name] = decode(valueBegin, cursor_);
+				if (!skipPast(">"))
+					return false;
+			}
+			else if (end_ - cursor_ >= 4 && !memcmp(cursor_, "<!--", 4)) {
+				if (!skipPast("-->"))
+					return false;
+			}
+			else
+				++cursor_;
+		}
+	}
+	return skipPast(">");
+}
+
+bool OwlReader::parseStartTag() {
+	auto const nameBegin = ++cursor_;
+	while (cursor_ < end_ && !isNameEnd(*cursor_))
+		++cursor_;
+	string const qName(nameBegin, cursor_);
+	vector<pair<string, string>> attributes;
+	while (true) {
+		while (cursor_ < end_ && isSpace(*cursor_))
+			++cursor_;
+		if (cursor_ == end_)
+			return false;
+		if (*cursor_ == '>') {
+			++cursor_;
+			startElement(qName, attributes, false);
+			return true;
+		}
+		if (*cursor_ == '/') {
+			if (end_ - cursor_ < 2 || cursor_[1] != '>')
+				return false;
+			cursor_ += 2;
+			startElement(qName, attributes, true);
+			endElement();
+			return true;
+		}
+		auto const attributeBegin = cursor_;
+		while (cursor_ < end_ && !isNameEnd(*cursor_))
+			++cursor_;
+		string const attributeName(attributeBegin, cursor_);
+		while (cursor_ < end_ && (isSpace(*cursor_) || *cursor_ == '='))
+			++cursor_;
+		if (cursor_ == end_ || *cursor_ != '"' && *cursor_ != '\'')
+			return false;
+		auto const& quote = *cursor_++;
+		auto const valueBegin = cursor_;
+		auto const& valueEnd = static_cast<char const*>(memchr(cursor_, quote, end_ - cursor_));
+		if (!valueEnd)
+			return false;
+		attributes.push_back(make_pair(attributeName, decode(valueBegin, valueEnd)));
+		cursor_ = valueEnd + 1;
+	}
+}
+
+bool OwlReader::parseEndTag() {
+	if (!skipPast(">") || depth_ == 0)
+		return false;
+	endElement();
+	return true;
+}
+
+void OwlReader::characters(char const* const& begin, char const* const& end) {
+	if (isCollectingLiteral_)
+		text_ += decode(begin, end);
+}
+
+void OwlReader::startElement(string const& qName, vector<pair<string, string>> const& attributes, bool const& isEmpty) {
+	++depth_;
+	for (auto attribute = attributes.begin(); attribute < attributes.end(); ++attribute)
+		if (attribute->first == "xmlns")
+			namespaces_.push_back(make_pair(depth_, make_pair(string(), attribute->second)));
+		else if (!attribute->first.compare(0, 6, "xmlns:"))
+			namespaces_.push_back(make_pair(depth_, make_pair(attribute->first.substr(6), attribute->second)));
+		else if (attribute->first == "xml:base")
+			bases_.push_back(make_pair(depth_, attribute->second));
+	if (depth_ == 2) {
+		subjectIndex_ = -1;
+		string iri;
+		for (auto attribute = attributes.begin(); attribute < attributes.end(); ++attribute) {
+			auto const& name = resolveName(attribute->first, true);
+			if (name == rdfNamespace + "about")
+				iri = resolveReference(attribute->second);
+			else if (name == rdfNamespace + "ID")
+				iri = resolveReference('#' + attribute->second);
+		}
+		if (iri.empty())
+			return;
+		auto const& tmpIt = subjectIndices_.find(iri);
+		if (tmpIt == subjectIndices_.end()) {
+			subjectIndex_ = static_cast<int>(subjects_.size());
+			subjectIndices_[iri] = subjectIndex_;
+			subjects_.push_back(Subject(iri));
+		}
+		else
+			subjectIndex_ = tmpIt->second;
+		auto& subject = subjects_[subjectIndex_];
+		string localName;
+		if (isOntLocalName(resolveName(qName, false), localName))
+			subject.types.push_back(localName);
+		for (auto attribute = attributes.begin(); attribute < attributes.end(); ++attribute)
+			if (isOntLocalName(resolveName(attribute->first, true), localName))
+				subject.literals.push_back(make_pair(localName, trim(attribute->second)));
+	}
+	else if (depth_ == 3 && subjectIndex_ >= 0) {
+		auto& subject = subjects_[subjectIndex_];
+		auto const& name = resolveName(qName, false);
+		string resource;
+		for (auto attribute = attributes.begin(); attribute < attributes.end(); ++attribute)
+			if (resolveName(attribute->first, true) == rdfNamespace + "resource")
+				resource = resolveReference(attribute->second);
+		string localName;
+		if (name == rdfNamespace + "type") {
+			if (isOntLocalName(resource, localName))
+				subject.types.push_back(localName);
+		}
+		else if (isOntLocalName(name, localName)) {
+			if (!resource.empty())
+				subject.resources.push_back(make_pair(localName, resource));
+			else if (!isEmpty) {
+				property_ = localName;
+				text_.clear();
+				isCollectingLiteral_ = true;
+			}
+		}
+	}
+	else if (depth_ > 3)
+		isCollectingLiteral_ = false;
+}
+
+void OwlReader::endElement() {
+	if (depth_ == 3 && isCollectingLiteral_) {
+		subjects_[subjectIndex_].literals.push_back(make_pair(property_, trim(text_)));
+		isCollectingLiteral_ = false;
+	}
+	while (!namespaces_.empty() && namespaces_.back().first == depth_)
+		namespaces_.pop_back();
+	while (!bases_.empty() && bases_.back().first == depth_)
+		bases_.pop_back();
+	--depth_;
+}
+
+string OwlReader::decode(char const* begin, char const* const& end) const {
+	string str;
+	str.reserve(end - begin);
+	while (begin < end) {
+		auto const& ampersand = static_cast<char const*>(memchr(begin, '&', end - begin));
+		if (!ampersand) {
+			str.append(begin, end);
+			break;
+		}
+		str.append(begin, ampersand);
+		auto const& semicolon = static_cast<char const*>(memchr(ampersand, ';', end - ampersand));
+		if (!semicolon) {
+			str.append(ampersand, end);
+			break;
+		}
+		string const name(ampersand + 1, semicolon);
+		if (name.size() > 1 && name[0] == '#')
+			appendUtf8(name[1] == 'x' ? strtoul(name.c_str() + 2, nullptr, 16) : strtoul(name.c_str() + 1, nullptr, 10), str);
+		else {
+			auto const& tmpIt = entities_.find(name);
+			if (tmpIt == entities_.end())
+				str.append(ampersand, semicolon + 1);
+			else
+				str += tmpIt->second;
+		}
+		begin = semicolon + 1;
+	}
+	return str;
+}
+
+string OwlReader::resolveName(string const& qName, bool const& isAttribute) const {
+	auto const& colon = qName.find(':');
+	if (colon == string::npos && isAttribute)
+		return qName;
+	auto const& prefix = colon == string::npos ? string() : qName.substr(0, colon);
+	if (prefix == "xml")
+		return xmlNamespace + qName.substr(colon + 1);
+	for (auto it = namespaces_.rbegin(); it < namespaces_.rend(); ++it)
+		if (it->second.first == prefix)
+			return it->second.second + (colon == string::npos ? qName : qName.substr(colon + 1));
+	return qName;
+}
+
+string OwlReader::resolveReference(string const& reference) const {
+	if (bases_.empty() || reference.find(':') != string::npos)
+		return reference;
+	auto const& base = bases_.back().second;
+	if (reference.empty())
+		return base;
+	if (reference[0] == '#')
+		return base.substr(0, base.find('#')) + reference;
+	return base.substr(0, base.rfind('/') + 1) + reference;
+}
+
+bool OwlReader::isOntLocalName(string const& iri, string& localName) {
+	if (iri.compare(0, ontPrefix.size(), ontPrefix))
+		return false;
+	localName = iri.substr(ontPrefix.size());
+	return true;
+}
+
+bool OwlReader::queryPosition(string const& iri, Rpd::Position& position) const {
+	auto const& tmpIt = subjectIndices_.find(iri);
+	if (tmpIt == subjectIndices_.end())
+		return false;
+	auto const& literals = subjects_[tmpIt->second].literals;
+	auto zone = -1, ordinal = -1;
+	for (auto literal = literals.begin(); literal < literals.end(); ++literal)
+		if (literal->first == "tooth_zone" && zone < 0)
+			zone = atoi(literal->second.c_str()) - 1;
+		else if (literal->first == "tooth_ordinal" && ordinal < 0)
+			ordinal = atoi(literal->second.c_str()) - 1;
+	if (zone < 0 || zone >= nZones || ordinal < 0 || ordinal >= nTeethPerZone)
+		return false;
+	position = Rpd::Position(zone, ordinal);
+	return true;
+}
+
+void OwlReader::collectIndividuals(vector<Individual>& individuals) const {
+	static map<string, int Individual::*> const intProperties = {
+		{"clasp_material", &Individual::claspMaterial},
+		{"clasp_tip_direction", &Individual::claspTipDirection},
+		{"clasp_tip_side", &Individual::claspTipSide},
+		{"rest_mesial_or_distal", &Individual::restMesialOrDistal}
+	};
+	static map<string, int Individual::*> const booleanProperties = {
+		{"enable_buccal_arm", &Individual::enableBuccalArm},
+		{"enable_lingual_arm", &Individual::enableLingualArm},
+		{"enable_rest", &Individual::enableRest},
+		{"is_missing", &Individual::isMissing}
+	};
+	for (auto subject = subjects_.begin(); subject < subjects_.end(); ++subject) {
+		auto tmpIt = rpdMapping_.end();
+		for (auto type = subject->types.begin(); type < subject->types.end() && tmpIt == rpdMapping_.end(); ++type)
+			tmpIt = rpdMapping_.find(*type);
+		if (tmpIt == rpdMapping_.end())
+			continue;
+		Individual individual(tmpIt->second);
+		for (auto literal = subject->literals.begin(); literal < subject->literals.end(); ++literal) {
+			auto tmpIt2 = intProperties.find(literal->first);
+			if (tmpIt2 != intProperties.end()) {
+				if (individual.*tmpIt2->second < 0)
+					individual.*tmpIt2->second = atoi(literal->second.c_str());
+			}
+			else if ((tmpIt2 = booleanProperties.find(literal->first)) != booleanProperties.end() && individual.*tmpIt2->second < 0)
+				individual.*tmpIt2->second = literal->second == "true" || literal->second == "1";
+		}
+		Rpd::Position position(0, 0);
+		if (individual.rpdClass == TOOTH) {
+			if (queryPosition(subject->iri, position))
+				individual.positions.push_back(position);
+		}
+		else
+			for (auto resource = subject->resources.begin(); resource < subject->resources.end(); ++resource)
+				if (resource->first == "component_position" && queryPosition(resource->second, position))
+					individual.positions.push_back(position);
+				else if (resource->first == "lingual_confrontation" && queryPosition(resource->second, position))
+					individual.lingualConfrontations.push_back(position);
+		individuals.push_back(individual);
+	}
+}
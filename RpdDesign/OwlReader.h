@@ -0,0 +1,42 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "Rpd.h"
+
+class OwlReader {
+public:
+	static bool read(string const& fileName, vector<Individual>& individuals);
+private:
+	struct Subject {
+		explicit Subject(string const& iri);
+		string iri;
+		vector<string> types;
+		vector<pair<string, string>> literals, resources;
+	};
+
+	OwlReader(char const* const& begin, char const* const& end);
+	bool parse();
+	bool parseDoctype();
+	bool parseEndTag();
+	bool parseStartTag();
+	bool skipPast(char const* const& token);
+	bool queryPosition(string const& iri, Rpd::Position& position) const;
+	void characters(char const* const& begin, char const* const& end);
+	void endElement();
+	void startElement(string const& qName, vector<pair<string, string>> const& attributes, bool const& isEmpty);
+	void collectIndividuals(vector<Individual>& individuals) const;
+	string decode(char const* begin, char const* const& end) const;
+	string resolveName(string const& qName, bool const& isAttribute) const;
+	string resolveReference(string const& reference) const;
+	static bool isOntLocalName(string const& iri, string& localName);
+	bool isCollectingLiteral_ = false;
+	char const *cursor_, *end_;
+	int depth_ = 0, subjectIndex_ = -1;
+	string property_, text_;
+	vector<pair<int, string>> bases_;
+	vector<pair<int, pair<string, string>>> namespaces_;
+	unordered_map<string, string> entities_;
+	unordered_map<string, int> subjectIndices_;
+	vector<Subject> subjects_;
+};
@@ -0,0 +1,12 @@
+﻿#include "ParallelTask.h"
+
+ParallelTask::ParallelTask(function<void(Range const&)> const& task) : task_(task) {}
+
+void ParallelTask::operator()(Range const& range) const { task_(range); }
+
+void ParallelTask::run(Range const& range, function<void(Range const&)> const& task, bool const& isParallel) {
+	if (isParallel)
+		parallel_for_(range, ParallelTask(task));
+	else
+		task(range);
+}
@@ -0,0 +1,15 @@
+﻿#pragma once
+
+#include <functional>
+#include <opencv2/core/utility.hpp>
+
+#include "GlobalVariables.h"
+
+class ParallelTask : public ParallelLoopBody {
+public:
+	explicit ParallelTask(function<void(Range const&)> const& task);
+	void operator()(Range const& range) const override;
+	static void run(Range const& range, function<void(Range const&)> const& task, bool const& isParallel = true);
+private:
+	function<void(Range const&)> task_;
+};
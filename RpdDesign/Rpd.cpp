@@ -1,7 +1,8 @@
 #include <opencv2/imgproc.hpp>
 
 #include "Rpd.h"
-#include "Tooth.h"
+#include "DisplayList.h"
+#include "TeethModel.h"
 #include "Utilities.h"
 
 Rpd::Position::Position(int const& zone, int const& ordinal) : zone(zone), ordinal(ordinal) {}
@@ -43,22 +44,17 @@ Rpd::Position Rpd::Position::operator--(int) {
 
 Rpd::Rpd(vector<Position> const& positions) : positions_(positions) {}
 
-void Rpd::queryPositions(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, vector<Position>& positions, bool (&isEighthToothUsed)[nZones], bool const& autoComplete) {
-	auto const& teeth = env->CallObjectMethod(individual, midListProperties, opComponentPosition);
-	auto count = 0;
-	while (env->CallBooleanMethod(teeth, midHasNext)) {
-		auto const& tooth = env->CallObjectMethod(teeth, midNext);
-		auto const& zone = env->CallIntMethod(env->CallObjectMethod(tooth, midStatementGetProperty, dpToothZone), midGetInt) - 1;
-		auto const& ordinal = env->CallIntMethod(env->CallObjectMethod(tooth, midStatementGetProperty, dpToothOrdinal), midGetInt) - 1;
-		positions.push_back(Position(zone, ordinal));
-		if (ordinal == nTeethPerZone - 1)
-			isEighthToothUsed[zone] = true;
-		++count;
-	}
-	for (auto i = 0; i < count - 1; ++i)
-		for (auto j = i + 1; j < count; ++j)
-			if (positions[i] > positions[j])
-				swap(positions[i], positions[j]);
+shared_ptr<Individual const> const& Rpd::getIndividual() const { return individual_; }
+
+void Rpd::setIndividual(Individual const& individual) { individual_ = make_shared<Individual const>(individual); }
+
+void Rpd::queryPositions(Individual const& individual, vector<Position>& positions, bool (&isEighthToothUsed)[nZones], bool const& autoComplete) {
+	positions = individual.positions;
+	auto const& count = positions.size();
+	for (auto position = positions.begin(); position < positions.end(); ++position)
+		if (position->ordinal == nTeethPerZone - 1)
+			isEighthToothUsed[position->zone] = true;
+	sort(positions.begin(), positions.end());
 	if (autoComplete && count == 1)
 		positions.push_back(positions[0]);
 	else if (count == 3)
@@ -68,38 +64,31 @@ void Rpd::queryPositions(JNIEnv* const& env, jmethodID const& midGetInt, jmethod
 			positions.insert(positions.begin(), positions[0]);
 }
 
+Individual::Individual(RpdClass const& rpdClass) : rpdClass(rpdClass) {}
+
+bool Individual::operator==(Individual const& rhs) const { return rpdClass == rhs.rpdClass && claspMaterial == rhs.claspMaterial && claspTipDirection == rhs.claspTipDirection && claspTipSide == rhs.claspTipSide && enableBuccalArm == rhs.enableBuccalArm && enableLingualArm == rhs.enableLingualArm && enableRest == rhs.enableRest && isMissing == rhs.isMissing && restMesialOrDistal == rhs.restMesialOrDistal && positions == rhs.positions && lingualConfrontations == rhs.lingualConfrontations; }
+
 RpdWithMaterial::RpdWithMaterial(Material const& material) : material_(material) {}
 
-void RpdWithMaterial::queryMaterial(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midResourceGetProperty, jobject const& dpClaspMaterial, jobject const& individual, Material& claspMaterial) {
-	auto const& tmp = env->CallObjectMethod(individual, midResourceGetProperty, dpClaspMaterial);
-	claspMaterial = tmp ? static_cast<Material>(env->CallIntMethod(tmp, midGetInt)) : CAST;
-}
+void RpdWithMaterial::queryMaterial(int const& value, Material& claspMaterial) { claspMaterial = value < 0 ? CAST : static_cast<Material>(value); }
 
 RpdWithDirection::RpdWithDirection(Rpd::Direction const& direction) : direction_(direction) {}
 
-void RpdWithDirection::queryDirection(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midResourceGetProperty, jobject const& dpClaspTipDirection, jobject const& individual, Rpd::Direction& claspTipDirection) {
-	auto const& tmp = env->CallObjectMethod(individual, midResourceGetProperty, dpClaspTipDirection);
-	claspTipDirection = tmp ? static_cast<Rpd::Direction>(env->CallIntMethod(tmp, midGetInt)) : Rpd::DISTAL;
-}
+void RpdWithDirection::queryDirection(int const& value, Rpd::Direction& direction) { direction = value < 0 ? Rpd::DISTAL : static_cast<Rpd::Direction>(value); }
 
-void RpdAsMajorConnector::registerMajorConnector(vector<Tooth> (&teeth)[nZones]) const { registerMajorConnector(teeth, positions_); }
+void RpdAsMajorConnector::registerMajorConnector(TeethModel& teeth) const { registerMajorConnector(teeth, positions_); }
 
-void RpdAsMajorConnector::registerMajorConnector(vector<Tooth> (&teeth)[nZones], vector<Position> const& positions) {
+void RpdAsMajorConnector::registerMajorConnector(TeethModel& teeth, vector<Position> const& positions) {
 	if (positions.size() == 2)
-		if (positions[0].zone == positions[1].zone)
-			for (auto position = positions[0]; position <= positions[1]; ++position)
-				getTooth(teeth, position).setMajorConnector();
-		else
-			for (auto i = 0; i < 2; ++i)
-				registerMajorConnector(teeth, {Position(positions[i].zone, 0), positions[i]});
+		teeth.setFlags(MAJOR_CONNECTOR, computeArchMask(positions[0], positions[1]));
 	else
 		for (auto i = 0; i < 3; ++i)
 			registerMajorConnector(teeth, {positions[i] , positions[++i]});
 }
 
-void RpdAsMajorConnector::registerExpectedAnchors(vector<Tooth> (&teeth)[nZones]) const { registerExpectedAnchors(teeth, positions_); }
+void RpdAsMajorConnector::registerExpectedAnchors(TeethModel& teeth) const { registerExpectedAnchors(teeth, positions_); }
 
-void RpdAsMajorConnector::registerExpectedAnchors(vector<Tooth> (&teeth)[nZones], vector<Position> const& positions) {
+void RpdAsMajorConnector::registerExpectedAnchors(TeethModel& teeth, vector<Position> const& positions) {
 	if (positions.size() == 2) {
 		getTooth(teeth, positions[0]).setExpectedMajorConnectorAnchor(positions[0].zone == positions[1].zone ? MESIAL : DISTAL);
 		getTooth(teeth, positions[1]).setExpectedMajorConnectorAnchor(DISTAL);
@@ -109,11 +98,13 @@ void RpdAsMajorConnector::registerExpectedAnchors(vector<Tooth> (&teeth)[nZones]
 			registerExpectedAnchors(teeth, {positions[i] , positions[++i]});
 }
 
-void RpdAsMajorConnector::registerLingualConfrontations(vector<Tooth> (&teeth)[nZones]) const {
+void RpdAsMajorConnector::registerLingualConfrontations(TeethModel& teeth) const {
+	uint32_t mask = 0;
 	for (auto zone = 0; zone < nZones; ++zone)
 		for (auto ordinal = 0; ordinal < nTeethPerZone; ++ordinal)
 			if (hasLingualConfrontations_[zone][ordinal])
-				teeth[zone][ordinal].setLingualConfrontation();
+				mask |= 1U << computeArchIndex(Position(zone, ordinal));
+	teeth.setFlags(LINGUAL_CONFRONTATION, mask);
 }
 
 RpdAsMajorConnector::RpdAsMajorConnector(vector<Position> const& positions, const bool (&hasLingualConfrontations)[nZones][nTeethPerZone]) : Rpd(positions) {
@@ -121,23 +112,21 @@ RpdAsMajorConnector::RpdAsMajorConnector(vector<Position> const& positions, cons
 		copy(begin(hasLingualConfrontations[zone]), end(hasLingualConfrontations[zone]), hasLingualConfrontations_[zone]);
 }
 
-void RpdAsMajorConnector::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void RpdAsMajorConnector::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	vector<vector<Point>> curves;
-	computeLingualConfrontationCurves(teeth, positions_, curves);
+	computeLingualConfrontationCurves(context, teeth, positions_, curves);
 	for (auto curve = curves.begin(); curve < curves.end(); ++curve)
-		polylines(designImage, *curve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+		displayList.addPolyline(*curve, false, 2);
 
 }
 
-void RpdAsMajorConnector::queryLingualConfrontations(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpLingualConfrontation, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& individual, bool (&hasLingualConfrontations)[nZones][nTeethPerZone]) {
-	auto const& lcTeeth = env->CallObjectMethod(individual, midListProperties, dpLingualConfrontation);
-	while (env->CallBooleanMethod(lcTeeth, midHasNext)) {
-		auto const& tooth = env->CallObjectMethod(lcTeeth, midNext);
-		hasLingualConfrontations[env->CallIntMethod(env->CallObjectMethod(tooth, midStatementGetProperty, dpToothZone), midGetInt) - 1][env->CallIntMethod(env->CallObjectMethod(tooth, midStatementGetProperty, dpToothOrdinal), midGetInt) - 1] = true;
-	}
+void RpdAsMajorConnector::queryLingualConfrontations(Individual const& individual, bool (&hasLingualConfrontations)[nZones][nTeethPerZone]) {
+	auto const& lcPositions = individual.lingualConfrontations;
+	for (auto position = lcPositions.begin(); position < lcPositions.end(); ++position)
+		hasLingualConfrontations[position->zone][position->ordinal] = true;
 }
 
-void RpdWithLingualCoverage::registerLingualCoverage(vector<Tooth> (&teeth)[nZones]) const {
+void RpdWithLingualCoverage::registerLingualCoverage(TeethModel& teeth) const {
 	deque<bool> tmpFlags(positions_.size());
 	for (auto flag = tmpFlags.begin(); flag < tmpFlags.end(); ++flag)
 		*flag = true;
@@ -148,13 +137,13 @@ RpdWithLingualCoverage::RpdWithLingualCoverage(vector<Position> const& positions
 
 RpdWithLingualCoverage::RpdWithLingualCoverage(vector<Position> const& positions, Material const& material, Direction const& rootDirection) : RpdWithLingualCoverage(positions, material, vector<Direction>{rootDirection}) {}
 
-void RpdWithLingualCoverage::registerLingualCoverage(vector<Tooth> (&teeth)[nZones], deque<bool> const& flags) const {
+void RpdWithLingualCoverage::registerLingualCoverage(TeethModel& teeth, deque<bool> const& flags) const {
 	for (auto i = 0; i < positions_.size(); ++i)
 		if (flags[i])
 			getTooth(teeth, positions_[i]).setLingualCoverage(rootDirections_[i]);
 }
 
-void RpdWithClaspRootOrRest::registerClaspRootOrRest(vector<Tooth> (&teeth)[nZones]) {
+void RpdWithClaspRootOrRest::registerClaspRootOrRest(TeethModel& teeth) {
 	for (auto i = 0; i < rootDirections_.size(); ++i)
 		getTooth(teeth, positions_[positions_.size() == 1 ? 0 : i]).setClaspRootOrRest(rootDirections_[i]);
 }
@@ -163,7 +152,7 @@ RpdWithClaspRootOrRest::RpdWithClaspRootOrRest(vector<Position> const& positions
 
 RpdWithClaspRootOrRest::RpdWithClaspRootOrRest(vector<Position> const& positions, Direction const& rootDirection) : RpdWithClaspRootOrRest(positions, vector<Direction>{rootDirection}) {}
 
-void RpdWithLingualClaspArms::setLingualClaspArms(vector<Tooth> (&teeth)[nZones]) {
+void RpdWithLingualClaspArms::setLingualClaspArms(TeethModel& teeth) {
 	for (auto i = 0; i < positions_.size(); ++i)
 		hasLingualArms_[i] = !getTooth(teeth, positions_[i]).hasLingualConfrontation();
 }
@@ -172,180 +161,177 @@ RpdWithLingualClaspArms::RpdWithLingualClaspArms(vector<Position> const& positio
 
 RpdWithLingualClaspArms::RpdWithLingualClaspArms(vector<Position> const& positions, Material const& material, Direction const& rootDirection) : RpdWithLingualClaspArms(positions, material, vector<Direction>{rootDirection}) {}
 
-void RpdWithLingualClaspArms::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void RpdWithLingualClaspArms::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	for (auto i = 0; i < positions_.size(); ++i)
 		if (hasLingualArms_[i])
-			HalfClasp(positions_[i], material_, ~rootDirections_[i], LINGUAL).draw(designImage, teeth);
+			HalfClasp(positions_[i], material_, ~rootDirections_[i], LINGUAL).draw(context, displayList, teeth);
 }
 
-void RpdWithLingualClaspArms::registerLingualCoverage(vector<Tooth> (&teeth)[nZones]) const { RpdWithLingualCoverage::registerLingualCoverage(teeth, hasLingualArms_); }
+void RpdWithLingualClaspArms::registerLingualCoverage(TeethModel& teeth) const { RpdWithLingualCoverage::registerLingualCoverage(teeth, hasLingualArms_); }
 
 RpdWithLingualRest::RpdWithLingualRest(vector<Position> const& positions, Material const& material, Direction const& direction) : Rpd(positions), RpdWithClaspRootOrRest(positions, direction), RpdWithLingualCoverage(positions, material, direction) {}
 
-void RpdWithLingualRest::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void RpdWithLingualRest::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	for (auto i = 0; i < positions_.size(); ++i)
-		LingualRest(vector<Position>{positions_[i]}, material_, RpdWithLingualCoverage::rootDirections_[i]).draw(designImage, teeth);
+		LingualRest(vector<Position>{positions_[i]}, material_, RpdWithLingualCoverage::rootDirections_[i]).draw(context, displayList, teeth);
 }
 
 AkersClasp::AkersClasp(vector<Position> const& positions, Material const& material, Direction const& direction, bool const& enableBuccalArm, bool const& enableLingualArm, bool const& enableRest) : Rpd(positions), RpdWithDirection(direction), RpdWithClaspRootOrRest(positions, ~direction), RpdWithLingualClaspArms(positions, material, ~direction), enableBuccalArm_(enableBuccalArm), enableRest_(enableRest) { hasLingualArms_[0] = enableLingualArm; }
 
-void AkersClasp::queryPartEnablements(JNIEnv* const& env, jmethodID const& midGetBoolean, jmethodID const& midResourceGetProperty, jobject const& dpEnableBuccalArm, jobject const& dpEnableLingualArm, jobject const& dpEnableRest, jobject const& individual, bool& enableBuccalArm, bool& enableLingualArm, bool& enableRest) {
-	auto tmp = env->CallObjectMethod(individual, midResourceGetProperty, dpEnableRest);
-	enableRest = tmp ? env->CallBooleanMethod(tmp, midGetBoolean) : true;
-	tmp = env->CallObjectMethod(individual, midResourceGetProperty, dpEnableBuccalArm);
-	enableBuccalArm = tmp ? env->CallBooleanMethod(tmp, midGetBoolean) : true;
-	tmp = env->CallObjectMethod(individual, midResourceGetProperty, dpEnableLingualArm);
-	enableLingualArm = tmp ? env->CallBooleanMethod(tmp, midGetBoolean) : true;
+void AkersClasp::queryPartEnablements(Individual const& individual, bool& enableBuccalArm, bool& enableLingualArm, bool& enableRest) {
+	enableRest = individual.enableRest != 0;
+	enableBuccalArm = individual.enableBuccalArm != 0;
+	enableLingualArm = individual.enableLingualArm != 0;
 }
 
-AkersClasp* AkersClasp::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetBoolean, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpClaspTipDirection, jobject const& dpClaspMaterial, jobject const& dpEnableBuccalArm, jobject const& dpEnableLingualArm, jobject const& dpEnableRest, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+AkersClasp* AkersClasp::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Direction claspTipDirection;
 	Material claspMaterial;
 	bool enableBuccalArm, enableLingualArm, enableRest;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryDirection(env, midGetInt, midResourceGetProperty, dpClaspTipDirection, individual, claspTipDirection);
-	queryMaterial(env, midGetInt, midResourceGetProperty, dpClaspMaterial, individual, claspMaterial);
-	queryPartEnablements(env, midGetBoolean, midResourceGetProperty, dpEnableBuccalArm, dpEnableLingualArm, dpEnableRest, individual, enableBuccalArm, enableLingualArm, enableRest);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryDirection(individual.claspTipDirection, claspTipDirection);
+	queryMaterial(individual.claspMaterial, claspMaterial);
+	queryPartEnablements(individual, enableBuccalArm, enableLingualArm, enableRest);
 	return new AkersClasp(positions, claspMaterial, claspTipDirection, enableBuccalArm, enableLingualArm, enableRest);
 }
 
-void AkersClasp::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	RpdWithLingualClaspArms::draw(designImage, teeth);
+void AkersClasp::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	RpdWithLingualClaspArms::draw(context, displayList, teeth);
 	if (enableRest_)
-		OcclusalRest(positions_, ~direction_).draw(designImage, teeth);
+		OcclusalRest(positions_, ~direction_).draw(context, displayList, teeth);
 	if (enableBuccalArm_)
-		HalfClasp(positions_, material_, direction_, BUCCAL).draw(designImage, teeth);
+		HalfClasp(positions_, material_, direction_, BUCCAL).draw(context, displayList, teeth);
 }
 
-void AkersClasp::setLingualClaspArms(vector<Tooth> (&teeth)[nZones]) {
+void AkersClasp::setLingualClaspArms(TeethModel& teeth) {
 	if (hasLingualArms_[0])
 		RpdWithLingualClaspArms::setLingualClaspArms(teeth);
 }
 
-CanineAkersClasp* CanineAkersClasp::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpClaspTipDirection, jobject const& dpClaspMaterial, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+CanineAkersClasp* CanineAkersClasp::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Direction claspTipDirection;
 	Material claspMaterial;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryDirection(env, midGetInt, midResourceGetProperty, dpClaspTipDirection, individual, claspTipDirection);
-	queryMaterial(env, midGetInt, midResourceGetProperty, dpClaspMaterial, individual, claspMaterial);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryDirection(individual.claspTipDirection, claspTipDirection);
+	queryMaterial(individual.claspMaterial, claspMaterial);
 	return new CanineAkersClasp(positions, claspMaterial, claspTipDirection);
 }
 
 CanineAkersClasp::CanineAkersClasp(vector<Position> const& positions, Material const& claspMaterial, Direction const& direction) : Rpd(positions), RpdWithDirection(direction), RpdWithLingualRest(positions, WROUGHT_WIRE, ~direction), claspMaterial_(claspMaterial) {}
 
-void CanineAkersClasp::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	RpdWithLingualRest::draw(designImage, teeth);
-	HalfClasp(positions_, claspMaterial_, direction_, BUCCAL).draw(designImage, teeth);
+void CanineAkersClasp::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	RpdWithLingualRest::draw(context, displayList, teeth);
+	HalfClasp(positions_, claspMaterial_, direction_, BUCCAL).draw(context, displayList, teeth);
 }
 
-CombinationAnteriorPosteriorPalatalStrap* CombinationAnteriorPosteriorPalatalStrap::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpLingualConfrontation, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+CombinationAnteriorPosteriorPalatalStrap* CombinationAnteriorPosteriorPalatalStrap::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	bool hasLingualConfrontations[nZones][nTeethPerZone] = {};
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryLingualConfrontations(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, individual, hasLingualConfrontations);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryLingualConfrontations(individual, hasLingualConfrontations);
 	return new CombinationAnteriorPosteriorPalatalStrap(positions, hasLingualConfrontations);
 }
 
 CombinationAnteriorPosteriorPalatalStrap::CombinationAnteriorPosteriorPalatalStrap(vector<Position> const& positions, const bool (&hasLingualConfrontations)[nZones][nTeethPerZone]) : RpdAsMajorConnector(positions, hasLingualConfrontations) {}
 
-void CombinationAnteriorPosteriorPalatalStrap::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	RpdAsMajorConnector::draw(designImage, teeth);
+void CombinationAnteriorPosteriorPalatalStrap::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	RpdAsMajorConnector::draw(context, displayList, teeth);
 	vector<int> mesialOrdinals;
 	vector<Point> curve, innerCurve, distalCurve, distalPoints;
 	vector<vector<Point>> curves;
 	if (!positions_[0].ordinal && !positions_[2].ordinal) {
 		mesialOrdinals = {1, 1};
-		computeLingualCurve(teeth, {positions_[1], positions_[3]}, curve, curves, &distalPoints);
+		computeLingualCurve(context, teeth, {positions_[1], positions_[3]}, curve, curves, &distalPoints);
 		reverse(curve.begin(), curve.end());
-		vector<Tooth> const& tmpTeeth = {getTooth(teeth, ++Position(positions_[2])), getTooth(teeth, positions_[2]), getTooth(teeth, positions_[0]), getTooth(teeth, ++Position(positions_[0]))};
-		innerCurve = {tmpTeeth[0].getCentroid(), (tmpTeeth[1].getCentroid() + tmpTeeth[2].getCentroid()) / 2, tmpTeeth[3].getCentroid()};
+		Tooth const* const tmpTeeth[]{&getTooth(teeth, ++Position(positions_[2])), &getTooth(teeth, positions_[2]), &getTooth(teeth, positions_[0]), &getTooth(teeth, ++Position(positions_[0]))};
+		innerCurve = {tmpTeeth[0]->getCentroid(), (tmpTeeth[1]->getCentroid() + tmpTeeth[2]->getCentroid()) / 2, tmpTeeth[3]->getCentroid()};
 		float sumOfRadii = 0;
-		auto const& nTeeth = tmpTeeth.size();
-		for (auto i = 0; i < nTeeth; ++i)
-			sumOfRadii += tmpTeeth[i].getRadius();
-		auto const& avgRadius = sumOfRadii / nTeeth;
-		for (auto point = innerCurve.begin(); point < innerCurve.end(); ++point)
-			*point -= roundToPoint(computeNormalDirection(*point) * avgRadius * distanceScales[MESIAL_OR_DISTAL]);
+		for (auto tooth = begin(tmpTeeth); tooth < end(tmpTeeth); ++tooth)
+			sumOfRadii += (*tooth)->getRadius();
+		auto const& avgRadius = sumOfRadii / (end(tmpTeeth) - begin(tmpTeeth));
+		vector<Point2f> normalDirections;
+		computeNormalDirections(context, innerCurve, normalDirections);
+		for (auto i = 0; i < innerCurve.size(); ++i)
+			innerCurve[i] -= roundToPoint(normalDirections[i] * avgRadius * distanceScales[MESIAL_OR_DISTAL]);
 	}
 	else {
 		vector<Point> mesialCurve, tmpCurve;
 		distalPoints = vector<Point>(2);
-		computeLingualCurve(teeth, {positions_[2], positions_[3]}, tmpCurve, curves, distalPoints[1]);
+		computeLingualCurve(context, teeth, {positions_[2], positions_[3]}, tmpCurve, curves, distalPoints[1]);
 		curve.insert(curve.end(), tmpCurve.rbegin(), tmpCurve.rend());
-		computeMesialCurve(teeth, {positions_[2], positions_[0]}, mesialCurve, mesialOrdinals, &innerCurve);
+		computeMesialCurve(context, teeth, {positions_[2], positions_[0]}, mesialCurve, mesialOrdinals, &innerCurve);
 		curve.insert(curve.end(), mesialCurve.begin(), mesialCurve.end());
-		computeLingualCurve(teeth, {positions_[0], positions_[1]}, tmpCurve, curves, distalPoints[0]);
+		computeLingualCurve(context, teeth, {positions_[0], positions_[1]}, tmpCurve, curves, distalPoints[0]);
 		curve.insert(curve.end(), tmpCurve.begin(), tmpCurve.end());
-		polylines(designImage, mesialCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+		displayList.addPolyline(mesialCurve, false, 2);
 	}
-	computeDistalCurve(teeth, {positions_[1], positions_[3]}, distalPoints, distalCurve, &mesialOrdinals, &innerCurve);
+	computeDistalCurve(context, teeth, {positions_[1], positions_[3]}, distalPoints, distalCurve, &mesialOrdinals, &innerCurve);
 	curve.insert(curve.end(), distalCurve.begin(), distalCurve.end());
-	polylines(designImage, distalCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+	displayList.addPolyline(distalCurve, false, 2);
 	for (auto thisCurve = curves.begin(); thisCurve < curves.end(); ++thisCurve)
-		polylines(designImage, *thisCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
-	polylines(designImage, innerCurve, true, 0, lineThicknessOfLevel[2], LINE_AA);
-	auto const& thisDesign = Mat(designImage.size(), CV_8U, 255);
-	fillPoly(thisDesign, vector<vector<Point>>{curve}, 128, LINE_AA);
-	fillPoly(thisDesign, vector<vector<Point>>{innerCurve}, 255, LINE_AA);
-	bitwise_and(thisDesign, designImage, designImage);
+		displayList.addPolyline(*thisCurve, false, 2);
+	displayList.addPolyline(innerCurve, true, 2);
+	displayList.addShade(curve, 128);
+	displayList.addShade(innerCurve, 255);
+	displayList.mergeShades();
 }
 
 CombinationClasp::CombinationClasp(vector<Position> const& positions, Direction const& direction) : Rpd(positions), RpdWithDirection(direction), RpdWithClaspRootOrRest(positions, ~direction), RpdWithLingualClaspArms(positions, CAST, ~direction) {}
 
-CombinationClasp* CombinationClasp::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpClaspTipDirection, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+CombinationClasp* CombinationClasp::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Direction claspTipDirection;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryDirection(env, midGetInt, midResourceGetProperty, dpClaspTipDirection, individual, claspTipDirection);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryDirection(individual.claspTipDirection, claspTipDirection);
 	return new CombinationClasp(positions, claspTipDirection);
 }
 
-void CombinationClasp::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	RpdWithLingualClaspArms::draw(designImage, teeth);
-	OcclusalRest(positions_, ~direction_).draw(designImage, teeth);
-	HalfClasp(positions_, WROUGHT_WIRE, direction_, BUCCAL).draw(designImage, teeth);
+void CombinationClasp::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	RpdWithLingualClaspArms::draw(context, displayList, teeth);
+	OcclusalRest(positions_, ~direction_).draw(context, displayList, teeth);
+	HalfClasp(positions_, WROUGHT_WIRE, direction_, BUCCAL).draw(context, displayList, teeth);
 }
 
 CombinedClasp::CombinedClasp(vector<Position> const& positions, Material const& material) : Rpd(positions), RpdWithClaspRootOrRest(positions, {positions[0].zone == positions[1].zone ? DISTAL : MESIAL, MESIAL}), RpdWithLingualClaspArms(positions, material, {positions[0].zone == positions[1].zone ? DISTAL : MESIAL, MESIAL}) {}
 
-CombinedClasp* CombinedClasp::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpClaspMaterial, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+CombinedClasp* CombinedClasp::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Material claspMaterial;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryMaterial(env, midGetInt, midResourceGetProperty, dpClaspMaterial, individual, claspMaterial);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryMaterial(individual.claspMaterial, claspMaterial);
 	return new CombinedClasp(positions, claspMaterial);
 }
 
-void CombinedClasp::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	RpdWithLingualClaspArms::draw(designImage, teeth);
+void CombinedClasp::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	RpdWithLingualClaspArms::draw(context, displayList, teeth);
 	auto isInSameZone = positions_[0].zone == positions_[1].zone;
-	OcclusalRest(positions_[0], isInSameZone ? DISTAL : MESIAL).draw(designImage, teeth);
-	OcclusalRest(positions_[1], MESIAL).draw(designImage, teeth);
-	HalfClasp(positions_[0], material_, isInSameZone ? MESIAL : DISTAL, BUCCAL).draw(designImage, teeth);
-	HalfClasp(positions_[1], material_, DISTAL, BUCCAL).draw(designImage, teeth);
+	OcclusalRest(positions_[0], isInSameZone ? DISTAL : MESIAL).draw(context, displayList, teeth);
+	OcclusalRest(positions_[1], MESIAL).draw(context, displayList, teeth);
+	HalfClasp(positions_[0], material_, isInSameZone ? MESIAL : DISTAL, BUCCAL).draw(context, displayList, teeth);
+	HalfClasp(positions_[1], material_, DISTAL, BUCCAL).draw(context, displayList, teeth);
 }
 
-ContinuousClasp* ContinuousClasp::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpClaspMaterial, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+ContinuousClasp* ContinuousClasp::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Material claspMaterial;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryMaterial(env, midGetInt, midResourceGetProperty, dpClaspMaterial, individual, claspMaterial);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryMaterial(individual.claspMaterial, claspMaterial);
 	return new ContinuousClasp(positions, claspMaterial);
 }
 
-void ContinuousClasp::setLingualClaspArms(vector<Tooth> (&teeth)[nZones]) {
+void ContinuousClasp::setLingualClaspArms(TeethModel& teeth) {
 	RpdWithLingualClaspArms::setLingualClaspArms(teeth);
 	hasLingualArms_[0] = hasLingualArms_[1] = hasLingualArms_[0] && hasLingualArms_[1];
 }
 
 ContinuousClasp::ContinuousClasp(vector<Position> const& positions, Material const& material) : Rpd(positions), RpdWithClaspRootOrRest(positions, {positions[0].zone == positions[1].zone ? MESIAL : DISTAL, DISTAL}), RpdWithLingualClaspArms(positions, material, {positions[0].zone == positions[1].zone ? MESIAL : DISTAL, DISTAL}) {}
 
-void ContinuousClasp::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void ContinuousClasp::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	auto const& isInSameZone = positions_[0].zone == positions_[1].zone;
-	OcclusalRest(positions_[0], isInSameZone ? MESIAL : DISTAL).draw(designImage, teeth);
-	OcclusalRest(positions_[1], DISTAL).draw(designImage, teeth);
+	OcclusalRest(positions_[0], isInSameZone ? MESIAL : DISTAL).draw(context, displayList, teeth);
+	OcclusalRest(positions_[1], DISTAL).draw(context, displayList, teeth);
 	auto const& hasLingualClaspArm = hasLingualArms_[0];
 	auto curve1 = getTooth(teeth, positions_[0]).getCurve(isInSameZone ? hasLingualClaspArm ? 180 : 0 : 60, isInSameZone ? 120 : hasLingualClaspArm ? 0 : 180), curve2 = getTooth(teeth, positions_[1]).getCurve(60, hasLingualClaspArm ? 0 : 180);
 	if (hasLingualClaspArm) {
@@ -354,60 +340,52 @@ void ContinuousClasp::draw(Mat const& designImage, const vector<Tooth> (&teeth)[
 		curve2.insert(curve2.end(), curve1.begin(), curve1.end());
 	}
 	else
-		polylines(designImage, curve1, false, 0, lineThicknessOfLevel[1 + (material_ == CAST)], LINE_AA);
-	polylines(designImage, curve2, false, 0, lineThicknessOfLevel[1 + (material_ == CAST)], LINE_AA);
+		displayList.addPolyline(curve1, false, 1 + (material_ == CAST));
+	displayList.addPolyline(curve2, false, 1 + (material_ == CAST));
 }
 
 DentureBase::DentureBase(vector<Position> const& positions) : Rpd(positions) {}
 
-DentureBase* DentureBase::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+DentureBase* DentureBase::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed, true);
+	queryPositions(individual, positions, isEighthToothUsed, true);
 	return new DentureBase(positions);
 }
 
-void DentureBase::setSide(const vector<Tooth> (&teeth)[nZones]) {
+void DentureBase::setSide(DesignContext const& context, TeethModel const& teeth) {
 	auto isCoveringTail = false;
 	for (auto i = 0; i < 2; ++i)
-		if (isLastTooth(positions_[i])) {
+		if (isLastTooth(context, positions_[i])) {
 			isCoveringTail = true;
 			break;
 		}
 	side_ = !isCoveringTail && isBlockedByMajorConnector(teeth, positions_) ? SINGLE : DOUBLE;
 }
 
-void DentureBase::registerDentureBase(vector<Tooth> (&teeth)[nZones]) const { registerDentureBase(teeth, positions_); }
+void DentureBase::registerDentureBase(TeethModel& teeth) const { registerDentureBase(teeth, positions_); }
 
-void DentureBase::registerExpectedAnchors(vector<Tooth> (&teeth)[nZones]) const { registerExpectedAnchors(teeth, positions_); }
+void DentureBase::registerExpectedAnchors(TeethModel& teeth) const { registerExpectedAnchors(teeth, positions_); }
 
-void DentureBase::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void DentureBase::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	if (side_ == DOUBLE) {
 		vector<vector<Point>> curves;
-		computeStringCurves(teeth, positions_, {distanceScales[DENTURE_BASE_CURVE], -distanceScales[DENTURE_BASE_CURVE]}, {true, true}, {true, true}, true, curves);
+		computeStringCurves(context, teeth, positions_, {distanceScales[DENTURE_BASE_CURVE], -distanceScales[DENTURE_BASE_CURVE]}, {true, true}, {true, true}, true, curves);
 		for (auto i = 0; i < 2; ++i)
-			computePiecewiseSmoothCurve(curves[i], curves[i]);
+			computePiecewiseSmoothCurve(context, curves[i], curves[i]);
 		curves[0].insert(curves[0].end(), curves[1].rbegin(), curves[1].rend());
-		polylines(designImage, curves[0], true, 0, lineThicknessOfLevel[2], LINE_AA);
+		displayList.addPolyline(curves[0], true, 2);
 	}
 	else {
 		vector<Point> curve;
-		computeStringCurve(teeth, positions_, distanceScales[DENTURE_BASE_CURVE], {true, true}, {true, true}, false, curve);
-		computeSmoothCurve(curve, curve);
-		polylines(designImage, curve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+		computeStringCurve(context, teeth, positions_, distanceScales[DENTURE_BASE_CURVE], {true, true}, {true, true}, false, curve);
+		computeSmoothCurve(context, curve, curve);
+		displayList.addPolyline(curve, false, 2);
 	}
 }
 
-void DentureBase::registerDentureBase(vector<Tooth> (&teeth)[nZones], vector<Position> positions) const {
-	if (positions[0].zone == positions[1].zone)
-		for (auto position = positions[0]; position <= positions[1]; ++position)
-			getTooth(teeth, position).setDentureBase(side_);
-	else {
-		registerDentureBase(teeth, {Position(positions[0].zone, 0), positions[0]});
-		registerDentureBase(teeth, {Position(positions[1].zone, 0), positions[1]});
-	}
-}
+void DentureBase::registerDentureBase(TeethModel& teeth, vector<Position> positions) const { teeth.setFlags(side_ == SINGLE ? SINGLE_SIDED_DENTURE_BASE : DOUBLE_SIDED_DENTURE_BASE, computeArchMask(positions[0], positions[1])); }
 
-void DentureBase::registerExpectedAnchors(vector<Tooth> (&teeth)[nZones], vector<Position> const& positions) {
+void DentureBase::registerExpectedAnchors(TeethModel& teeth, vector<Position> const& positions) {
 	if (positions.size() == 2) {
 		getTooth(teeth, positions[0]).setExpectedDentureBaseAnchor(positions[0].zone == positions[1].zone ? MESIAL : DISTAL);
 		getTooth(teeth, positions[1]).setExpectedDentureBaseAnchor(DISTAL);
@@ -420,287 +398,265 @@ void DentureBase::registerExpectedAnchors(vector<Tooth> (&teeth)[nZones], vector
 
 EdentulousSpace::EdentulousSpace(vector<Position> const& positions) : Rpd(positions) {}
 
-EdentulousSpace* EdentulousSpace::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+EdentulousSpace* EdentulousSpace::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed, true);
+	queryPositions(individual, positions, isEighthToothUsed, true);
 	return new EdentulousSpace(positions);
 }
 
-void EdentulousSpace::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void EdentulousSpace::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	vector<vector<Point>> curves;
-	computeStringCurves(teeth, positions_, {0.25F, -0.25F}, {false, false}, {false, false}, false, curves);
+	computeStringCurves(context, teeth, positions_, {0.25F, -0.25F}, {false, false}, {false, false}, false, curves);
 	for (auto curve = curves.begin(); curve < curves.end(); ++curve) {
-		computeSmoothCurve(*curve, *curve);
-		polylines(designImage, *curve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+		computeSmoothCurve(context, *curve, *curve);
+		displayList.addPolyline(*curve, false, 2);
 	}
 }
 
-FullPalatalPlate* FullPalatalPlate::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpLingualConfrontation, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+FullPalatalPlate* FullPalatalPlate::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	bool hasLingualConfrontations[nZones][nTeethPerZone] = {};
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryLingualConfrontations(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, individual, hasLingualConfrontations);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryLingualConfrontations(individual, hasLingualConfrontations);
 	return new FullPalatalPlate(positions, hasLingualConfrontations);
 }
 
 FullPalatalPlate::FullPalatalPlate(vector<Position> const& positions, const bool (&hasLingualConfrontations)[nZones][nTeethPerZone]) : RpdAsMajorConnector(positions, hasLingualConfrontations) {}
 
-void FullPalatalPlate::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	RpdAsMajorConnector::draw(designImage, teeth);
+void FullPalatalPlate::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	RpdAsMajorConnector::draw(context, displayList, teeth);
 	vector<Point> curve, distalCurve, distalPoints;
 	vector<vector<Point>> curves;
-	computeLingualCurve(teeth, positions_, curve, curves, &distalPoints);
-	computeDistalCurve(teeth, positions_, distalPoints, distalCurve);
+	computeLingualCurve(context, teeth, positions_, curve, curves, &distalPoints);
+	computeDistalCurve(context, teeth, positions_, distalPoints, distalCurve);
 	curve.insert(curve.end(), distalCurve.rbegin(), distalCurve.rend());
-	polylines(designImage, distalCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+	displayList.addPolyline(distalCurve, false, 2);
 	for (auto thisCurve = curves.begin(); thisCurve < curves.end(); ++thisCurve)
-		polylines(designImage, *thisCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
-	auto const& thisDesign = Mat(designImage.size(), CV_8U, 255);
-	fillPoly(thisDesign, vector<vector<Point>>{curve}, 128, LINE_AA);
-	bitwise_and(thisDesign, designImage, designImage);
+		displayList.addPolyline(*thisCurve, false, 2);
+	displayList.addShade(curve, 128);
+	displayList.mergeShades();
 }
 
-LingualBar* LingualBar::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpLingualConfrontation, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+LingualBar* LingualBar::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	bool hasLingualConfrontations[nZones][nTeethPerZone] = {};
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryLingualConfrontations(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, individual, hasLingualConfrontations);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryLingualConfrontations(individual, hasLingualConfrontations);
 	return new LingualBar(positions, hasLingualConfrontations);
 }
 
 LingualBar::LingualBar(vector<Position> const& positions, const bool (&hasLingualConfrontations)[nZones][nTeethPerZone]) : RpdAsMajorConnector(positions, hasLingualConfrontations) {}
 
-void LingualBar::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void LingualBar::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	vector<Point> curve, tmpCurve;
 	vector<vector<Point>> curves;
 	float avgRadius;
-	computeOuterCurve(teeth, positions_, curve, &avgRadius);
-	computeInnerCurve(teeth, positions_, avgRadius, tmpCurve, curves);
-	polylines(designImage, curve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+	computeOuterCurve(context, teeth, positions_, curve, &avgRadius);
+	computeInnerCurve(context, teeth, positions_, avgRadius, tmpCurve, curves);
+	displayList.addPolyline(curve, false, 2);
 	for (auto thisCurve = curves.begin(); thisCurve < curves.end(); ++thisCurve)
-		polylines(designImage, *thisCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+		displayList.addPolyline(*thisCurve, false, 2);
 	curve.insert(curve.end(), tmpCurve.rbegin(), tmpCurve.rend());
-	auto const& thisDesign = Mat(designImage.size(), CV_8U, 255);
-	fillPoly(thisDesign, vector<vector<Point>>{curve}, 128, LINE_AA);
-	bitwise_and(thisDesign, designImage, designImage);
+	displayList.addShade(curve, 128);
+	displayList.mergeShades();
 }
 
-LingualPlate* LingualPlate::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpLingualConfrontation, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+LingualPlate* LingualPlate::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	bool hasLingualConfrontations[nZones][nTeethPerZone] = {};
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryLingualConfrontations(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, individual, hasLingualConfrontations);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryLingualConfrontations(individual, hasLingualConfrontations);
 	return new LingualPlate(positions, hasLingualConfrontations);
 }
 
 LingualPlate::LingualPlate(vector<Position> const& positions, const bool (&hasLingualConfrontations)[nZones][nTeethPerZone]) : RpdAsMajorConnector(positions, hasLingualConfrontations) {}
 
-void LingualPlate::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	RpdAsMajorConnector::draw(designImage, teeth);
+void LingualPlate::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	RpdAsMajorConnector::draw(context, displayList, teeth);
 	vector<Point> curve, tmpCurve;
 	vector<vector<Point>> curves;
-	computeOuterCurve(teeth, positions_, curve);
-	computeLingualCurve(teeth, positions_, tmpCurve, curves);
-	polylines(designImage, curve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+	computeOuterCurve(context, teeth, positions_, curve);
+	computeLingualCurve(context, teeth, positions_, tmpCurve, curves);
+	displayList.addPolyline(curve, false, 2);
 	for (auto thisCurve = curves.begin(); thisCurve < curves.end(); ++thisCurve)
-		polylines(designImage, *thisCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+		displayList.addPolyline(*thisCurve, false, 2);
 	curve.insert(curve.end(), tmpCurve.rbegin(), tmpCurve.rend());
-	auto const& thisDesign = Mat(designImage.size(), CV_8U, 255);
-	fillPoly(thisDesign, vector<vector<Point>>{curve}, 128, LINE_AA);
-	bitwise_and(thisDesign, designImage, designImage);
+	displayList.addShade(curve, 128);
+	displayList.mergeShades();
 }
 
 LingualRest::LingualRest(vector<Position> const& positions, Material const& material, Direction const& direction) : Rpd(positions), RpdWithDirection(direction), RpdWithLingualRest(positions, material, direction) {}
 
-LingualRest* LingualRest::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpRestMesialOrDistal, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+LingualRest* LingualRest::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Direction restMesialOrDistal;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryDirection(env, midGetInt, midResourceGetProperty, dpRestMesialOrDistal, individual, restMesialOrDistal);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryDirection(individual.restMesialOrDistal, restMesialOrDistal);
 	return new LingualRest(positions, CAST, restMesialOrDistal);
 }
 
-void LingualRest::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void LingualRest::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	auto& tooth = getTooth(teeth, positions_[0]);
 	auto curve = tooth.getCurve(240, 300);
 	vector<Point> tmpCurve{curve.back(), curve[0]};
 	auto& centroid = tooth.getCentroid();
 	for (auto i = 0; i < 2; ++i)
 		tmpCurve.insert(tmpCurve.end() - 1, centroid + (static_cast<Point2f>(tmpCurve[i * 2]) - centroid) * 0.8F);
-	computePiecewiseSmoothCurve(tmpCurve, tmpCurve);
+	computePiecewiseSmoothCurve(context, tmpCurve, tmpCurve);
 	curve.insert(curve.end(), tmpCurve.begin(), tmpCurve.end());
-	polylines(designImage, curve, true, 0, lineThicknessOfLevel[1 + (material_ == CAST)], LINE_AA);
-	fillPoly(designImage, vector<vector<Point>>{curve}, 0, LINE_AA);
+	displayList.addPolyline(curve, true, 1 + (material_ == CAST));
+	displayList.addFill(curve, 0);
 	auto const& isMesial = direction_ == MESIAL;
-	polylines(designImage, tooth.getCurve(isMesial ? 300 : 180, isMesial ? 0 : 240), false, 0, lineThicknessOfLevel[1 + (material_ == CAST)], LINE_AA);
+	displayList.addPolyline(tooth.getCurve(isMesial ? 300 : 180, isMesial ? 0 : 240), false, 1 + (material_ == CAST));
 }
 
 OcclusalRest::OcclusalRest(vector<Position> const& positions, Direction const& direction) : Rpd(positions), RpdWithDirection(direction), RpdWithClaspRootOrRest(positions, direction) {}
 
 OcclusalRest::OcclusalRest(Position const& position, Direction const& direction) : OcclusalRest(vector<Position>{position}, direction) {}
 
-OcclusalRest* OcclusalRest::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpRestMesialOrDistal, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+OcclusalRest* OcclusalRest::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Direction restMesialOrDistal;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryDirection(env, midGetInt, midResourceGetProperty, dpRestMesialOrDistal, individual, restMesialOrDistal);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryDirection(individual.restMesialOrDistal, restMesialOrDistal);
 	return new OcclusalRest(positions, restMesialOrDistal);
 }
 
-void OcclusalRest::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void OcclusalRest::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	auto& tooth = getTooth(teeth, positions_[0]);
 	auto const& isMesial = direction_ == MESIAL;
 	auto curve = tooth.getCurve(isMesial ? 340 : 160, isMesial ? 20 : 200);
 	vector<Point> tmpCurve{curve.back(), (tooth.getCentroid() + static_cast<Point2f>(tooth.getAnglePoint(isMesial ? 0 : 180))) / 2, curve[0]};
-	computeSmoothCurve(tmpCurve, tmpCurve, false, 0.3F);
+	computeSmoothCurve(context, tmpCurve, tmpCurve, false, 0.3F);
 	curve.insert(curve.end(), tmpCurve.begin(), tmpCurve.end());
-	polylines(designImage, curve, true, 0, lineThicknessOfLevel[1], LINE_AA);
-	fillPoly(designImage, vector<vector<Point>>{curve}, 0, LINE_AA);
+	displayList.addPolyline(curve, true, 1);
+	displayList.addFill(curve, 0);
 }
 
-PalatalPlate* PalatalPlate::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpLingualConfrontation, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+PalatalPlate* PalatalPlate::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	bool hasLingualConfrontations[nZones][nTeethPerZone] = {};
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryLingualConfrontations(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, individual, hasLingualConfrontations);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryLingualConfrontations(individual, hasLingualConfrontations);
 	return new PalatalPlate(positions, hasLingualConfrontations);
 }
 
 PalatalPlate::PalatalPlate(vector<Position> const& positions, const bool (&hasLingualConfrontations)[nZones][nTeethPerZone]) : RpdAsMajorConnector(positions, hasLingualConfrontations) {}
 
-void PalatalPlate::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	RpdAsMajorConnector::draw(designImage, teeth);
+void PalatalPlate::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	RpdAsMajorConnector::draw(context, displayList, teeth);
 	vector<int> mesialOrdinals;
 	vector<Point> curve, mesialCurve, distalCurve, tmpCurve, distalPoints(2);
 	vector<vector<Point>> curves;
-	computeLingualCurve(teeth, {positions_[2], positions_[3]}, tmpCurve, curves, distalPoints[1]);
+	computeLingualCurve(context, teeth, {positions_[2], positions_[3]}, tmpCurve, curves, distalPoints[1]);
 	curve.insert(curve.end(), tmpCurve.rbegin(), tmpCurve.rend());
-	computeMesialCurve(teeth, {positions_[2], positions_[0]}, mesialCurve, mesialOrdinals);
+	computeMesialCurve(context, teeth, {positions_[2], positions_[0]}, mesialCurve, mesialOrdinals);
 	curve.insert(curve.end(), mesialCurve.begin(), mesialCurve.end());
-	computeLingualCurve(teeth, {positions_[0], positions_[1]}, tmpCurve, curves, distalPoints[0]);
+	computeLingualCurve(context, teeth, {positions_[0], positions_[1]}, tmpCurve, curves, distalPoints[0]);
 	curve.insert(curve.end(), tmpCurve.begin(), tmpCurve.end());
-	computeDistalCurve(teeth, {positions_[1], positions_[3]}, distalPoints, distalCurve, &mesialOrdinals);
+	computeDistalCurve(context, teeth, {positions_[1], positions_[3]}, distalPoints, distalCurve, &mesialOrdinals);
 	curve.insert(curve.end(), distalCurve.begin(), distalCurve.end());
-	polylines(designImage, mesialCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
-	polylines(designImage, distalCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
+	displayList.addPolyline(mesialCurve, false, 2);
+	displayList.addPolyline(distalCurve, false, 2);
 	for (auto thisCurve = curves.begin(); thisCurve < curves.end(); ++thisCurve)
-		polylines(designImage, *thisCurve, false, 0, lineThicknessOfLevel[2], LINE_AA);
-	auto const& thisDesign = Mat(designImage.size(), CV_8U, 255);
-	fillPoly(thisDesign, vector<vector<Point>>{curve}, 128, LINE_AA);
-	bitwise_and(thisDesign, designImage, designImage);
+		displayList.addPolyline(*thisCurve, false, 2);
+	displayList.addShade(curve, 128);
+	displayList.mergeShades();
 }
 
 RingClasp::RingClasp(vector<Position> const& positions, Material const& material, Side const& tipSide) : Rpd(positions), RpdWithClaspRootOrRest(positions, material == CAST ? vector<Direction>{MESIAL, DISTAL} : vector<Direction>{MESIAL}), RpdWithLingualClaspArms(positions, material, MESIAL), tipSide_(tipSide) {}
 
-RingClasp* RingClasp::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpClaspMaterial, jobject const& dpClaspTipSide, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+RingClasp* RingClasp::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Material claspMaterial;
 	Side tipSide;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryMaterial(env, midGetInt, midResourceGetProperty, dpClaspMaterial, individual, claspMaterial);
-	queryTipSide(env, midGetInt, midResourceGetProperty, dpClaspTipSide, individual, tipSide);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryMaterial(individual.claspMaterial, claspMaterial);
+	queryTipSide(individual.claspTipSide, tipSide);
 	return new RingClasp(positions, claspMaterial, tipSide);
 }
 
-void RingClasp::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	OcclusalRest(positions_, MESIAL).draw(designImage, teeth);
+void RingClasp::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	OcclusalRest(positions_, MESIAL).draw(context, displayList, teeth);
 	if (material_ == CAST)
-		OcclusalRest(positions_, DISTAL).draw(designImage, teeth);
+		OcclusalRest(positions_, DISTAL).draw(context, displayList, teeth);
 	auto const& isBuccal = tipSide_ == BUCCAL;
-	polylines(designImage, getTooth(teeth, positions_[0]).getCurve(isBuccal ? 60 : 0, isBuccal ? 0 : 300), false, 0, lineThicknessOfLevel[1 + (material_ == CAST)], LINE_AA);
+	displayList.addPolyline(getTooth(teeth, positions_[0]).getCurve(isBuccal ? 60 : 0, isBuccal ? 0 : 300), false, 1 + (material_ == CAST));
 }
 
-void RingClasp::queryTipSide(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midResourceGetProperty, jobject const& dpClaspTipSide, jobject const& individual, Side& tipSide) {
-	auto const& tmp = env->CallObjectMethod(individual, midResourceGetProperty, dpClaspTipSide);
-	tipSide = tmp ? static_cast<Side>(env->CallIntMethod(tmp, midGetInt)) : BUCCAL;
-}
+void RingClasp::queryTipSide(int const& value, Side& tipSide) { tipSide = value < 0 ? BUCCAL : static_cast<Side>(value); }
 
 Rpa::Rpa(vector<Position> const& positions, Material const& material) : Rpd(positions), RpdWithMaterial(material), RpdWithClaspRootOrRest(positions, {MESIAL, DISTAL}) {}
 
-Rpa* Rpa::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpClaspMaterial, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+Rpa* Rpa::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Material claspMaterial;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryMaterial(env, midGetInt, midResourceGetProperty, dpClaspMaterial, individual, claspMaterial);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryMaterial(individual.claspMaterial, claspMaterial);
 	return new Rpa(positions, claspMaterial);
 }
 
-void Rpa::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	OcclusalRest(positions_, MESIAL).draw(designImage, teeth);
-	GuidingPlate(positions_).draw(designImage, teeth);
-	HalfClasp(positions_, material_, MESIAL, BUCCAL).draw(designImage, teeth);
+void Rpa::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	OcclusalRest(positions_, MESIAL).draw(context, displayList, teeth);
+	GuidingPlate(positions_).draw(context, displayList, teeth);
+	HalfClasp(positions_, material_, MESIAL, BUCCAL).draw(context, displayList, teeth);
 }
 
 Rpi::Rpi(vector<Position> const& positions) : Rpd(positions), RpdWithClaspRootOrRest(positions, {MESIAL, DISTAL}) {}
 
-Rpi* Rpi::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midStatementGetProperty, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+Rpi* Rpi::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
+	queryPositions(individual, positions, isEighthToothUsed);
 	return new Rpi(positions);
 }
 
-void Rpi::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	OcclusalRest(positions_, MESIAL).draw(designImage, teeth);
-	GuidingPlate(positions_).draw(designImage, teeth);
-	IBar(positions_).draw(designImage, teeth);
+void Rpi::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	OcclusalRest(positions_, MESIAL).draw(context, displayList, teeth);
+	GuidingPlate(positions_).draw(context, displayList, teeth);
+	IBar(positions_).draw(context, displayList, teeth);
 }
 
 WwClasp::WwClasp(vector<Position> const& positions, Direction const& direction, bool const& enableBuccalArm, bool const& enableLingualArm, bool const& enableRest) : Rpd(positions), AkersClasp(positions, WROUGHT_WIRE, direction, enableBuccalArm, enableLingualArm, enableRest) {}
 
-WwClasp* WwClasp::createFromIndividual(JNIEnv* const& env, jmethodID const& midGetBoolean, jmethodID const& midGetInt, jmethodID const& midHasNext, jmethodID const& midListProperties, jmethodID const& midNext, jmethodID const& midResourceGetProperty, jmethodID const& midStatementGetProperty, jobject const& dpClaspTipDirection, jobject const& dpEnableBuccalArm, jobject const& dpEnableLingualArm, jobject const& dpEnableRest, jobject const& dpToothZone, jobject const& dpToothOrdinal, jobject const& opComponentPosition, jobject const& individual, bool (&isEighthToothUsed)[nZones]) {
+WwClasp* WwClasp::createFromIndividual(Individual const& individual, bool (&isEighthToothUsed)[nZones]) {
 	vector<Position> positions;
 	Direction claspTipDirection;
 	bool enableBuccalArm, enableLingualArm, enableRest;
-	queryPositions(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, positions, isEighthToothUsed);
-	queryDirection(env, midGetInt, midResourceGetProperty, dpClaspTipDirection, individual, claspTipDirection);
-	queryPartEnablements(env, midGetBoolean, midResourceGetProperty, dpEnableBuccalArm, dpEnableLingualArm, dpEnableRest, individual, enableBuccalArm, enableLingualArm, enableRest);
+	queryPositions(individual, positions, isEighthToothUsed);
+	queryDirection(individual.claspTipDirection, claspTipDirection);
+	queryPartEnablements(individual, enableBuccalArm, enableLingualArm, enableRest);
 	return new WwClasp(positions, claspTipDirection, enableBuccalArm, enableLingualArm, enableRest);
 }
 
 GuidingPlate::GuidingPlate(vector<Position> const& positions) : Rpd(positions) {}
 
-void GuidingPlate::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void GuidingPlate::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	auto& tooth = getTooth(teeth, positions_[0]);
 	auto& centroid = tooth.getCentroid();
 	auto const& point = centroid + (static_cast<Point2f>(tooth.getAnglePoint(180)) - centroid) * 1.1F;
-	auto const& direction = computeNormalDirection(point) * tooth.getRadius() * 2 / 3;
-	line(designImage, point, point + direction, 0, lineThicknessOfLevel[2], LINE_AA);
-	line(designImage, point, point - direction, 0, lineThicknessOfLevel[2], LINE_AA);
+	auto const& direction = computeNormalDirection(context, point) * tooth.getRadius() * 2 / 3;
+	displayList.addPolyline({point, point + direction}, false, 2);
+	displayList.addPolyline({point, point - direction}, false, 2);
 }
 
 HalfClasp::HalfClasp(vector<Position> const& positions, Material const& material, Direction const& direction, Side const& side) : Rpd(positions), RpdWithMaterial(material), RpdWithDirection(direction), side_(side) {}
 
 HalfClasp::HalfClasp(Position const& position, Material const& material, Direction const& direction, Side const& side) : HalfClasp(vector<Position>{position}, material, direction, side) {}
 
-void HalfClasp::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
-	auto& tooth = getTooth(teeth, positions_[0]);
-	vector<Point> curve;
-	switch ((direction_ == DISTAL) * 2 + (side_ == LINGUAL)) {
-		case 0b00:
-			curve = tooth.getCurve(60, 180);
-			break;
-		case 0b01:
-			curve = tooth.getCurve(180, 300);
-			break;
-		case 0b10:
-			curve = tooth.getCurve(0, 120);
-			break;
-		case 0b11:
-			curve = tooth.getCurve(240, 0);
-			break;
-		default: ;
-	}
-	polylines(designImage, curve, false, 0, lineThicknessOfLevel[1 + (material_ == CAST)], LINE_AA);
+void HalfClasp::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
+	int const angles[][2]{{60, 180}, {180, 300}, {0, 120}, {240, 0}};
+	auto const& thisAngles = angles[(direction_ == DISTAL) * 2 + (side_ == LINGUAL)];
+	displayList.addPolyline(getTooth(teeth, positions_[0]).getCurve(thisAngles[0], thisAngles[1]), false, 1 + (material_ == CAST));
 }
 
 IBar::IBar(vector<Position> const& positions) : Rpd(positions) {}
 
-void IBar::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) const {
+void IBar::draw(DesignContext const& context, DisplayList& displayList, TeethModel const& teeth) const {
 	auto& tooth = getTooth(teeth, positions_[0]);
 	auto const& a = tooth.getRadius() * 1.5F;
 	auto &p1 = tooth.getAnglePoint(75), &p2 = tooth.getAnglePoint(165);
 	auto const& c = (p1 + p2) / 2;
-	auto const& d = computeNormalDirection(c);
+	auto const& d = computeNormalDirection(context, c);
 	auto const& r = p1 - c;
 	auto const& rou = norm(r);
 	auto const& sinTheta = d.cross(r) / rou;
@@ -710,5 +666,5 @@ void IBar::draw(Mat const& designImage, const vector<Tooth> (&teeth)[nZones]) co
 	inclination = radianToDegree(inclination);
 	if (t > 0)
 		t -= 180;
-	ellipse(designImage, c, Size(a, b), inclination, t, t + 180, 0, lineThicknessOfLevel[2], LINE_AA);
+	displayList.addArc(c, Size(a, b), inclination, t, t + 180, 2);
 }
@@ -1,24 +1,26 @@
-#define WIN32_LEAN_AND_MEAN
+﻿#define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <fstream>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
 #include <QFileDialog>
 #include <QMessageBox>
 
+#include "BaseImageCache.h"
+#include "DefaultBase.h"
 #include "RpdDesign.h"
 #include "resource.h"
 #include "RpdViewer.h"
-#include "Tooth.h"
+#include "TeethModel.h"
 #include "Utilities.h"
+#include "WorkerPool.h"
 
-string RpdDesign::jenaLibPath = "D:/Utilities/apache-jena-3.3.0/lib/";
-
-RpdDesign::RpdDesign(QWidget* const& parent) : QWidget(parent) {
+RpdDesign::RpdDesign(QWidget* const& parent) : QWidget(parent), analysisWorker_(new WorkerPool(1)) {
 	ui_.setupUi(this);
 	rpdViewer_ = new RpdViewer(this);
 	ui_.verticalLayout->insertWidget(0, rpdViewer_);
 	setMinimumSize(600, 600);
-	remedyImage = ui_.remedyCheckBox->isChecked();
+	remedyImage_ = ui_.remedyCheckBox->isChecked();
 	showBaseImage_ = ui_.baseCheckBox->isChecked();
 	showDesignImage_ = ui_.designCheckBox->isChecked();
 	chsTranslator_.load(":/qrc/rpddesign_zh.qm");
@@ -32,23 +34,11 @@ RpdDesign::RpdDesign(QWidget* const& parent) : QWidget(parent) {
 	connect(ui_.remedyCheckBox, SIGNAL(toggled(bool)), this, SLOT(onRemedyImageChanged(bool const&)));
 	connect(ui_.baseCheckBox, SIGNAL(toggled(bool)), this, SLOT(onShowBaseChanged(bool const&)));
 	connect(ui_.designCheckBox, SIGNAL(toggled(bool)), this, SLOT(onShowDesignChanged(bool const&)));
-	JavaVMInitArgs vmInitArgs;
-	vmInitArgs.version = JNI_VERSION_1_8;
-	vmInitArgs.nOptions = 1;
-	vmInitArgs.options = new JavaVMOption[1];
-	string optionString = "-Djava.class.path=";
-	catPath(optionString, jenaLibPath, "*.jar");
-	vmInitArgs.options[0].optionString = const_cast<char*>(optionString.c_str());
-	vmInitArgs.ignoreUnrecognized = false;
-	JNI_CreateJavaVM(&vm_, reinterpret_cast<void**>(&env_), &vmInitArgs);
-	delete[] vmInitArgs.options;
 }
 
 RpdDesign::~RpdDesign() {
-	for (auto rpd = rpds_.begin(); rpd < rpds_.end(); ++rpd)
-		delete *rpd;
+	analysisWorker_.reset();
 	delete rpdViewer_;
-	vm_->DestroyJavaVM();
 }
 
 void RpdDesign::changeEvent(QEvent* event) {
@@ -68,9 +58,9 @@ void RpdDesign::changeEvent(QEvent* event) {
 }
 
 void RpdDesign::updateViewer() {
-	auto const& curImage = !remedyImage && showBaseImage_ ? baseImage_.clone() : Mat((remedyImage ? remediedDesignImages_[0].size : designImages_[0].size)(), CV_8UC3, Scalar::all(255));
+	auto const& curImage = !remedyImage_ && showBaseImage_ ? baseImage_.clone() : Mat((remedyImage_ ? remediedDesignImages_[0].size : designImages_[0].size)(), CV_8UC3, Scalar::all(255));
 	if (showDesignImage_) {
-		auto designImages = remedyImage ? remediedDesignImages_ : designImages_;
+		auto designImages = remedyImage_ ? remediedDesignImages_ : designImages_;
 		Mat designImage;
 		bitwise_and(designImages[0], designImages[1], designImage);
 		cvtColor(designImage, designImage, COLOR_GRAY2BGR);
@@ -79,10 +69,20 @@ void RpdDesign::updateViewer() {
 	rpdViewer_->setCurImage(curImage);
 }
 
-void RpdDesign::analyzeAndUpdate(Mat const& base) {
-	analyzeBaseImage(base, remediedTeeth_, remediedDesignImages_, &teeth_, &designImages_, &baseImage_);
-	updateDesign(teeth_, rpds_, designImages_, false, true, justLoadedRpds_);
-	updateDesign(remediedTeeth_, rpds_, remediedDesignImages_, true, true, justLoadedRpds_);
+void RpdDesign::analyzeAndUpdate(function<void(BaseAnalysis&)> const& analyze) {
+	pendingAnalyses_.push(analysisWorker_->submit([this, analyze] {
+		BaseAnalysis analysis;
+		analyze(analysis);
+		QMetaObject::invokeMethod(this, "onBaseImageAnalyzed", Qt::QueuedConnection);
+		return analysis;
+	}));
+}
+
+void RpdDesign::updateAll() {
+	updateDesign(context_, teeth_, rpds_, displayList_, false, true, justLoadedRpds_, &designGraph_);
+	updateDesign(context_, remediedTeeth_, rpds_, remediedDisplayList_, true, true, justLoadedRpds_, &remediedDesignGraph_);
+	rasterizeDesign(displayList_, designImages_, &designGraph_);
+	rasterizeDesign(remediedDisplayList_, remediedDesignImages_, &remediedDesignGraph_);
 	justLoadedRpds_ = false;
 	updateViewer();
 }
@@ -94,37 +94,29 @@ void RpdDesign::loadBaseImage() {
 		if (image.empty())
 			QMessageBox::critical(this, tr("Error"), tr("Not a Valid Image!"));
 		else
-			analyzeAndUpdate(image);
+			analyzeAndUpdate([image](BaseAnalysis& analysis) { BaseImageCache::analyze(image, analysis.context, analysis.remediedTeeth, analysis.remediedDesignImages, &analysis.teeth, &analysis.designImages, &analysis.baseImage); });
 	}
 }
 
 void RpdDesign::loadDefaultBaseImage() {
 	auto const& hRsrc = FindResource(nullptr, MAKEINTRESOURCE(IDB_PNG1), TEXT("PNG"));
 	auto const& pBuf = static_cast<uchar*>(LockResource(LoadResource(nullptr, hRsrc)));
-	analyzeAndUpdate(imdecode(vector<uchar>(pBuf, pBuf + SizeofResource(nullptr, hRsrc)), IMREAD_COLOR));
+	auto const& size = SizeofResource(nullptr, hRsrc);
+	analyzeAndUpdate([pBuf, size](BaseAnalysis& analysis) {
+		DefaultBase::load(analysis.context, analysis.remediedTeeth, analysis.remediedDesignImages, &analysis.teeth, &analysis.designImages);
+		copyMakeBorder(imdecode(vector<uchar>(pBuf, pBuf + size), IMREAD_COLOR), analysis.baseImage, 80, 80, 80, 80, BORDER_CONSTANT, Scalar::all(255));
+	});
 }
 
 void RpdDesign::loadRpdInfo() {
-	auto const& fileName = QFileDialog::getOpenFileName(this, tr("Select RPD Information"), "", tr("Ontology files (*.owl)"));
+	auto const& fileName = QFileDialog::getOpenFileName(this, tr("Select RPD Information"), "", tr("Ontology files (*.owl);;Design specs (*.rpds)"));
 	if (!fileName.isEmpty()) {
-		auto const& clsStrModel = "org/apache/jena/rdf/model/Model";
-		auto const& clsStrModelFactory = "org/apache/jena/rdf/model/ModelFactory";
-		auto const& clsStrOntModel = "org/apache/jena/ontology/OntModel";
-		auto const& clsStrOntModelSpec = "org/apache/jena/ontology/OntModelSpec";
-		auto const& clsStrString = "java/lang/String";
-		auto const& clsModelFactory = env_->FindClass(clsStrModelFactory);
-		auto const& clsModel = env_->FindClass(clsStrModel);
-		auto const& clsOntModelSpec = env_->FindClass(clsStrOntModelSpec);
-		auto const& midCreateOntologyModel = env_->GetStaticMethodID(clsModelFactory, "createOntologyModel", ('(' + getClsSig(clsStrOntModelSpec) + ')' + getClsSig(clsStrOntModel)).c_str());
-		auto const& midRead = env_->GetMethodID(clsModel, "read", ('(' + getClsSig(clsStrString) + ')' + getClsSig(clsStrModel)).c_str());
-		auto const& ontModel = env_->CallStaticObjectMethod(clsModelFactory, midCreateOntologyModel, env_->GetStaticObjectField(clsOntModelSpec, env_->GetStaticFieldID(clsOntModelSpec, "OWL_DL_MEM", getClsSig(clsStrOntModelSpec).c_str())));
-		auto const& tmpStr = env_->NewStringUTF(fileName.toUtf8().data());
-		env_->CallVoidMethod(ontModel, midRead, tmpStr);
-		env_->DeleteLocalRef(tmpStr);
-		if (queryRpds(env_, ontModel, rpds_))
-			if (baseImage_.data) {
-				updateDesign(teeth_, rpds_, designImages_, false, false, true);
-				updateDesign(remediedTeeth_, rpds_, remediedDesignImages_, true, false, true);
+		if (queryRpds(fileName.toLocal8Bit().data(), rpds_, context_.isEighthUsed))
+			if (baseImage_.data && pendingAnalyses_.empty()) {
+				updateDesign(context_, teeth_, rpds_, displayList_, false, false, true, &designGraph_);
+				updateDesign(context_, remediedTeeth_, rpds_, remediedDisplayList_, true, false, true, &remediedDesignGraph_);
+				rasterizeDesign(displayList_, designImages_, &designGraph_);
+				rasterizeDesign(remediedDisplayList_, remediedDesignImages_, &remediedDesignGraph_);
 				updateViewer();
 			}
 			else
@@ -134,9 +126,22 @@ void RpdDesign::loadRpdInfo() {
 	}
 }
 
+void RpdDesign::onBaseImageAnalyzed() {
+	auto analysis = pendingAnalyses_.front().get();
+	pendingAnalyses_.pop();
+	context_.teethEllipse = analysis.context.teethEllipse;
+	context_.remediedTeethEllipse = analysis.context.remediedTeethEllipse;
+	baseImage_ = analysis.baseImage;
+	swap(designImages_, analysis.designImages);
+	swap(remediedDesignImages_, analysis.remediedDesignImages);
+	swap(teeth_, analysis.teeth);
+	swap(remediedTeeth_, analysis.remediedTeeth);
+	updateAll();
+}
+
 void RpdDesign::onRemedyImageChanged(bool const& thisRemedyImage) {
-	remedyImage = thisRemedyImage;
-	ui_.baseCheckBox->setEnabled(!remedyImage);
+	remedyImage_ = thisRemedyImage;
+	ui_.baseCheckBox->setEnabled(!remedyImage_);
 	if (baseImage_.data)
 		updateViewer();
 }
@@ -156,8 +161,12 @@ void RpdDesign::onShowDesignChanged(bool const& showDesignImage) {
 void RpdDesign::saveDesign() {
 	auto& curImage = rpdViewer_->getCurImage();
 	if (curImage.data) {
-		auto const& fileName = QFileDialog::getSaveFileName(this, tr("Select Save Path"), "", tr("Windows bitmaps (*.bmp *.dib);;JPEG files (*.jpeg *.jpg *.jpe);;JPEG 2000 files (*.jp2);;Portable Network Graphics (*.png);;Portable image format (*.pbm *.pgm *.ppm);;Sun rasters (*.sr *.ras);;TIFF files (*.tiff *.tif)"), new QString(tr("Portable Network Graphics (*.png)")));
-		if (!fileName.isEmpty())
+		auto const& fileName = QFileDialog::getSaveFileName(this, tr("Select Save Path"), "", tr("Windows bitmaps (*.bmp *.dib);;JPEG files (*.jpeg *.jpg *.jpe);;JPEG 2000 files (*.jp2);;Portable Network Graphics (*.png);;Portable image format (*.pbm *.pgm *.ppm);;Sun rasters (*.sr *.ras);;TIFF files (*.tiff *.tif);;Scalable Vector Graphics (*.svg);;Portable Document Format (*.pdf)"), new QString(tr("Portable Network Graphics (*.png)")));
+		if (fileName.endsWith(".svg", Qt::CaseInsensitive) || fileName.endsWith(".pdf", Qt::CaseInsensitive)) {
+			ofstream stream(fileName.toLocal8Bit().data(), ios::binary);
+			exportDesign(remedyImage_ ? remediedTeeth_ : teeth_, remedyImage_ ? remediedDisplayList_ : displayList_, curImage.size(), stream, fileName.endsWith(".pdf", Qt::CaseInsensitive));
+		}
+		else if (!fileName.isEmpty())
 			imwrite(fileName.toLocal8Bit().data(), curImage);
 	}
 	else
@@ -1,15 +1,21 @@
 #pragma once
 
-#include <jni.h>
+#include <functional>
+#include <future>
+#include <memory>
 #include <opencv2/core/mat.hpp>
+#include <queue>
 #include <QTranslator>
 
 #include "ui_RpdDesign.h"
+#include "DesignGraph.h"
+#include "DisplayList.h"
 #include "GlobalVariables.h"
+#include "RpdStore.h"
+#include "TeethModel.h"
 
-class Rpd;
 class RpdViewer;
-class Tooth;
+class WorkerPool;
 
 class RpdDesign : public QWidget {
 	Q_OBJECT
@@ -17,21 +23,31 @@ public:
 	explicit RpdDesign(QWidget* const& parent = nullptr);
 	~RpdDesign();
 private:
+	struct BaseAnalysis {
+		DesignContext context;
+		Mat baseImage, designImages[2], remediedDesignImages[2];
+		TeethModel teeth, remediedTeeth;
+	};
+
 	void changeEvent(QEvent* event) override;
 	void updateViewer();
-	void analyzeAndUpdate(Mat const& base);
-	static string jenaLibPath;
+	void analyzeAndUpdate(function<void(BaseAnalysis&)> const& analyze);
+	void updateAll();
 	bool isEnglish_ = true;
-	bool justLoadedRpds_ = false, showBaseImage_, showDesignImage_;
-	JavaVM* vm_;
-	JNIEnv* env_;
+	bool justLoadedRpds_ = false, remedyImage_, showBaseImage_, showDesignImage_;
+	DesignContext context_;
+	DesignGraph designGraph_, remediedDesignGraph_;
+	DisplayList displayList_, remediedDisplayList_;
 	Mat baseImage_, designImages_[2], remediedDesignImages_[2];
+	queue<future<BaseAnalysis>> pendingAnalyses_;
 	QTranslator chsTranslator_, engTranslator_;
+	unique_ptr<WorkerPool> analysisWorker_;
+	RpdStore rpds_;
 	RpdViewer* rpdViewer_;
 	Ui::RpdDesignClass ui_;
-	vector<Rpd*> rpds_;
-	vector<Tooth> teeth_[nZones], remediedTeeth_[nZones];
+	TeethModel teeth_, remediedTeeth_;
 private slots:
+	void onBaseImageAnalyzed();
 	void loadBaseImage();
 	void loadDefaultBaseImage();
 	void loadRpdInfo();
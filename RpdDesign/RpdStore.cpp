@@ -0,0 +1,35 @@
+﻿#include <opencv2/core.hpp>
+
+#include "RpdStore.h"
+
+void RpdStore::clear() {
+	rpds_.clear();
+	dentureBases_.clear();
+	majorConnectors_.clear();
+	rpdsWithClaspRootOrRest_.clear();
+	rpdsWithLingualClaspArms_.clear();
+	rpdsWithLingualCoverage_.clear();
+}
+
+bool RpdStore::empty() const { return rpds_.empty(); }
+
+int RpdStore::size() const { return rpds_.size(); }
+
+int RpdStore::indexOf(Rpd const* const& rpd) const {
+	for (auto thisRpd = rpds_.begin(); thisRpd < rpds_.end(); ++thisRpd)
+		if (thisRpd->get() == rpd)
+			return thisRpd - rpds_.begin();
+	return -1;
+}
+
+vector<unique_ptr<Rpd>> const& RpdStore::getRpds() const { return rpds_; }
+
+vector<DentureBase*> const& RpdStore::getDentureBases() const { return dentureBases_; }
+
+vector<RpdAsMajorConnector*> const& RpdStore::getMajorConnectors() const { return majorConnectors_; }
+
+vector<RpdWithClaspRootOrRest*> const& RpdStore::getRpdsWithClaspRootOrRest() const { return rpdsWithClaspRootOrRest_; }
+
+vector<RpdWithLingualClaspArms*> const& RpdStore::getRpdsWithLingualClaspArms() const { return rpdsWithLingualClaspArms_; }
+
+vector<RpdWithLingualCoverage*> const& RpdStore::getRpdsWithLingualCoverage() const { return rpdsWithLingualCoverage_; }
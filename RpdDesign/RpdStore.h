@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include "Rpd.h"
+
+class RpdStore {
+public:
+	template <typename T>
+	void add(T* const& rpd);
+	void clear();
+	bool empty() const;
+	int size() const;
+	int indexOf(Rpd const* const& rpd) const;
+	vector<unique_ptr<Rpd>> const& getRpds() const;
+	vector<DentureBase*> const& getDentureBases() const;
+	vector<RpdAsMajorConnector*> const& getMajorConnectors() const;
+	vector<RpdWithClaspRootOrRest*> const& getRpdsWithClaspRootOrRest() const;
+	vector<RpdWithLingualClaspArms*> const& getRpdsWithLingualClaspArms() const;
+	vector<RpdWithLingualCoverage*> const& getRpdsWithLingualCoverage() const;
+private:
+	template <typename T, typename U>
+	static void add(vector<U*>& rpds, T* const& rpd, true_type);
+	template <typename T, typename U>
+	static void add(vector<U*>& rpds, T* const& rpd, false_type);
+	vector<unique_ptr<Rpd>> rpds_;
+	vector<DentureBase*> dentureBases_;
+	vector<RpdAsMajorConnector*> majorConnectors_;
+	vector<RpdWithClaspRootOrRest*> rpdsWithClaspRootOrRest_;
+	vector<RpdWithLingualClaspArms*> rpdsWithLingualClaspArms_;
+	vector<RpdWithLingualCoverage*> rpdsWithLingualCoverage_;
+};
+
+template <typename T>
+void RpdStore::add(T* const& rpd) {
+	rpds_.push_back(unique_ptr<Rpd>(rpd));
+	add(dentureBases_, rpd, is_base_of<DentureBase, T>());
+	add(majorConnectors_, rpd, is_base_of<RpdAsMajorConnector, T>());
+	add(rpdsWithClaspRootOrRest_, rpd, is_base_of<RpdWithClaspRootOrRest, T>());
+	add(rpdsWithLingualClaspArms_, rpd, is_base_of<RpdWithLingualClaspArms, T>());
+	add(rpdsWithLingualCoverage_, rpd, is_base_of<RpdWithLingualCoverage, T>());
+}
+
+template <typename T, typename U>
+void RpdStore::add(vector<U*>& rpds, T* const& rpd, true_type) { rpds.push_back(rpd); }
+
+template <typename T, typename U>
+void RpdStore::add(vector<U*>&, T* const&, false_type) {}
@@ -0,0 +1,385 @@
+#include <istream>
+#include <opencv2/imgproc.hpp>
+#include <ostream>
+
+#include "TeethModel.h"
+#include "Utilities.h"
+
+TeethModel::TeethModel(TeethModel const& teethModel) { *this = teethModel; }
+
+TeethModel::TeethModel(TeethModel&& teethModel) { *this = move(teethModel); }
+
+TeethModel::TeethModel(istream& stream) {
+	uint32_t nTeeth, nPoints;
+	stream.read(reinterpret_cast<char*>(&nTeeth), sizeof nTeeth);
+	stream.read(reinterpret_cast<char*>(&nPoints), sizeof nPoints);
+	if (!stream || nTeeth > nZones * nTeethPerZone || nPoints > 1 << 24 || computeRemainingSize(stream) < static_cast<streamoff>(nTeeth) * (sizeof(float) + 3 * sizeof(int) + 2 * sizeof(Point2f) + sizeof(uint8_t)) + static_cast<streamoff>(nPoints) * sizeof(Point)) {
+		stream.setstate(ios::failbit);
+		return;
+	}
+	radii_.resize(nTeeth);
+	zones_.resize(nTeeth);
+	centroids_.resize(nTeeth);
+	normalDirections_.resize(nTeeth);
+	contourOffsets_.resize(nTeeth);
+	contourSizes_.resize(nTeeth);
+	points_.resize(nPoints);
+	anglePointIndices_.resize(nTeeth);
+	vector<uint8_t> isSwept(nTeeth);
+	stream.read(reinterpret_cast<char*>(radii_.data()), nTeeth * sizeof(float));
+	stream.read(reinterpret_cast<char*>(zones_.data()), nTeeth * sizeof(int));
+	stream.read(reinterpret_cast<char*>(centroids_.data()), nTeeth * sizeof(Point2f));
+	stream.read(reinterpret_cast<char*>(normalDirections_.data()), nTeeth * sizeof(Point2f));
+	stream.read(reinterpret_cast<char*>(contourOffsets_.data()), nTeeth * sizeof(int));
+	stream.read(reinterpret_cast<char*>(contourSizes_.data()), nTeeth * sizeof(int));
+	stream.read(reinterpret_cast<char*>(isSwept.data()), nTeeth * sizeof(uint8_t));
+	for (auto no = 0; no < static_cast<int>(nTeeth); ++no)
+		if (isSwept[no]) {
+			anglePointIndices_[no].resize(360);
+			stream.read(reinterpret_cast<char*>(anglePointIndices_[no].data()), 360 * sizeof(int));
+		}
+	stream.read(reinterpret_cast<char*>(points_.data()), nPoints * sizeof(Point));
+	for (auto no = 0; no < static_cast<int>(nTeeth); ++no) {
+		if (contourOffsets_[no] < 0 || contourSizes_[no] <= 0 || contourOffsets_[no] + contourSizes_[no] > static_cast<int>(nPoints))
+			stream.setstate(ios::failbit);
+		for (auto it = anglePointIndices_[no].begin(); it < anglePointIndices_[no].end(); ++it)
+			if (*it < 0 || *it >= contourSizes_[no])
+				stream.setstate(ios::failbit);
+	}
+	if (stream)
+		bindTeeth();
+	else
+		*this = TeethModel();
+}
+
+TeethModel::TeethModel(vector<vector<Point>> const& contours, vector<int> const& zones, vector<Point2f> const& normalDirections) : zones_(zones), normalDirections_(normalDirections) {
+	auto const& nTeeth = static_cast<int>(contours.size());
+	radii_.resize(nTeeth);
+	centroids_.resize(nTeeth);
+	anglePointIndices_.resize(nTeeth);
+	for (auto no = 0; no < nTeeth; ++no) {
+		auto const& contour = contours[no];
+		centroids_[no] = computeCentroid(contour, &radii_[no]);
+		contourOffsets_.push_back(points_.size());
+		contourSizes_.push_back(contour.size());
+		points_.insert(points_.end(), contour.begin(), contour.end());
+	}
+	bindTeeth();
+}
+
+TeethModel::TeethModel(vector<Point> const& points, vector<int> const& contourOffsets, vector<int> const& zones, vector<float> const& radii, vector<Point2f> const& centroids, vector<Point2f> const& normalDirections, vector<int> const& anglePointIndices) : radii_(radii), zones_(zones), centroids_(centroids), normalDirections_(normalDirections), contourOffsets_(contourOffsets.begin(), contourOffsets.end() - 1), points_(points) {
+	for (auto offset = contourOffsets.begin() + 1; offset < contourOffsets.end(); ++offset)
+		contourSizes_.push_back(*offset - *(offset - 1));
+	for (auto it = anglePointIndices.begin(); it < anglePointIndices.end(); it += 360)
+		anglePointIndices_.push_back(vector<int>(it, it + 360));
+	bindTeeth();
+}
+
+TeethModel& TeethModel::operator=(TeethModel const& teethModel) {
+	radii_ = teethModel.radii_;
+	zones_ = teethModel.zones_;
+	centroids_ = teethModel.centroids_;
+	normalDirections_ = teethModel.normalDirections_;
+	teeth_ = teethModel.teeth_;
+	contourOffsets_ = teethModel.contourOffsets_;
+	contourSizes_ = teethModel.contourSizes_;
+	points_ = teethModel.points_;
+	anglePointIndices_ = teethModel.anglePointIndices_;
+	curves_ = teethModel.curves_;
+	copy(std::begin(teethModel.flags_), std::end(teethModel.flags_), flags_);
+	bindTeeth();
+	return *this;
+}
+
+TeethModel& TeethModel::operator=(TeethModel&& teethModel) {
+	radii_ = move(teethModel.radii_);
+	zones_ = move(teethModel.zones_);
+	centroids_ = move(teethModel.centroids_);
+	normalDirections_ = move(teethModel.normalDirections_);
+	teeth_ = move(teethModel.teeth_);
+	contourOffsets_ = move(teethModel.contourOffsets_);
+	contourSizes_ = move(teethModel.contourSizes_);
+	points_ = move(teethModel.points_);
+	anglePointIndices_ = move(teethModel.anglePointIndices_);
+	curves_ = move(teethModel.curves_);
+	copy(std::begin(teethModel.flags_), std::end(teethModel.flags_), flags_);
+	bindTeeth();
+	return *this;
+}
+
+Tooth* TeethModel::operator[](int const& zone) { return teeth_.data() + zone * nTeethPerZone; }
+
+Tooth const* TeethModel::operator[](int const& zone) const { return teeth_.data() + zone * nTeethPerZone; }
+
+Tooth* TeethModel::begin() { return teeth_.data(); }
+
+Tooth const* TeethModel::begin() const { return teeth_.data(); }
+
+Tooth* TeethModel::end() { return teeth_.data() + teeth_.size(); }
+
+Tooth const* TeethModel::end() const { return teeth_.data() + teeth_.size(); }
+
+int TeethModel::size() const { return zones_.size(); }
+
+void TeethModel::addReadFlags(ToothFlag const& flag, uint32_t const& mask) const { readFlags_[flag] |= mask; }
+
+uint32_t TeethModel::getFlags(ToothFlag const& flag, uint32_t const& mask) const {
+	addReadFlags(flag, mask);
+	return peekFlags(flag, mask);
+}
+
+uint32_t const& TeethModel::getReadFlags(ToothFlag const& flag) const { return readFlags_[flag]; }
+
+uint32_t TeethModel::peekFlags(ToothFlag const& flag, uint32_t const& mask) const { return flags_[flag] & mask; }
+
+void TeethModel::setFlags(ToothFlag const& flag, uint32_t const& mask) { flags_[flag] |= mask; }
+
+void TeethModel::unsetFlags() { fill(std::begin(flags_), std::end(flags_), 0); }
+
+void TeethModel::unsetReadFlags() const { fill(std::begin(readFlags_), std::end(readFlags_), 0); }
+
+void TeethModel::write(ostream& stream) const {
+	auto const& nTeeth = static_cast<uint32_t>(zones_.size());
+	auto const& nPoints = static_cast<uint32_t>(points_.size());
+	vector<uint8_t> isSwept;
+	for (auto it = anglePointIndices_.begin(); it < anglePointIndices_.end(); ++it)
+		isSwept.push_back(!it->empty());
+	stream.write(reinterpret_cast<char const*>(&nTeeth), sizeof nTeeth);
+	stream.write(reinterpret_cast<char const*>(&nPoints), sizeof nPoints);
+	stream.write(reinterpret_cast<char const*>(radii_.data()), nTeeth * sizeof(float));
+	stream.write(reinterpret_cast<char const*>(zones_.data()), nTeeth * sizeof(int));
+	stream.write(reinterpret_cast<char const*>(centroids_.data()), nTeeth * sizeof(Point2f));
+	stream.write(reinterpret_cast<char const*>(normalDirections_.data()), nTeeth * sizeof(Point2f));
+	stream.write(reinterpret_cast<char const*>(contourOffsets_.data()), nTeeth * sizeof(int));
+	stream.write(reinterpret_cast<char const*>(contourSizes_.data()), nTeeth * sizeof(int));
+	stream.write(reinterpret_cast<char const*>(isSwept.data()), nTeeth * sizeof(uint8_t));
+	for (auto it = anglePointIndices_.begin(); it < anglePointIndices_.end(); ++it)
+		stream.write(reinterpret_cast<char const*>(it->data()), it->size() * sizeof(int));
+	stream.write(reinterpret_cast<char const*>(points_.data()), nPoints * sizeof(Point));
+}
+
+vector<Point> const& TeethModel::getCurve(int const& no, int const& startAngle, int const& endAngle, bool const& isConvex) const {
+	findAnglePoints(no);
+	auto& curve = curves_[((no * 360 + startAngle) * 360 + endAngle) * 2 + isConvex];
+	if (curve.empty())
+		curve = computeCurve(no, startAngle, endAngle, isConvex);
+	return curve;
+}
+
+vector<Point> TeethModel::computeCurve(int const& no, int const& startAngle, int const& endAngle, bool const& isConvex) const {
+	auto midAngle = (startAngle + endAngle) / 2;
+	if (startAngle > endAngle)
+		midAngle = (midAngle + 180) % 360;
+	auto const& anglePointIndices = anglePointIndices_[no].data();
+	auto const& startIdx = anglePointIndices[startAngle];
+	auto const& midIdx = anglePointIndices[midAngle];
+	auto const& endIdx = anglePointIndices[endAngle];
+	auto const& contourBegin = points_.data() + contourOffsets_[no];
+	auto const& contourEnd = contourBegin + contourSizes_[no];
+	reverse_iterator<Point const*> const contourRBegin(contourEnd), contourREnd(contourBegin);
+	vector<Point> curve;
+	if ((midIdx - startIdx) * (endIdx - midIdx) >= 0)
+		if (startIdx < endIdx)
+			curve = vector<Point>(contourBegin + startIdx, contourBegin + endIdx + 1);
+		else
+			curve = vector<Point>(contourREnd - startIdx - 1, contourREnd - endIdx);
+	else if (startIdx < endIdx) {
+		curve = vector<Point>(contourREnd - startIdx - 1, contourREnd);
+		curve.insert(curve.end(), contourRBegin, contourREnd - endIdx);
+	}
+	else {
+		curve = vector<Point>(contourBegin + startIdx, contourEnd);
+		curve.insert(curve.end(), contourBegin, contourBegin + endIdx + 1);
+	}
+	if (isConvex) {
+		vector<int> convexIdx;
+		convexHull(curve, convexIdx);
+		auto const& minMaxIts = minmax_element(convexIdx.begin(), convexIdx.end());
+		vector<Point> convexCurve;
+		if (minMaxIts.first < minMaxIts.second)
+			if ((minMaxIts.second - minMaxIts.first) * 2 >= convexIdx.size())
+				for (auto it = minMaxIts.first; it <= minMaxIts.second; ++it)
+					convexCurve.push_back(curve[*it]);
+			else {
+				for (auto it = vector<int>::reverse_iterator(minMaxIts.first) - 1; it < convexIdx.rend(); ++it)
+					convexCurve.push_back(curve[*it]);
+				for (auto it = convexIdx.rbegin(); it < vector<int>::reverse_iterator(minMaxIts.second); ++it)
+					convexCurve.push_back(curve[*it]);
+			}
+		else if ((minMaxIts.first - minMaxIts.second) * 2 >= convexIdx.size())
+			for (auto it = vector<int>::reverse_iterator(minMaxIts.first) - 1; it < vector<int>::reverse_iterator(minMaxIts.second); ++it)
+				convexCurve.push_back(curve[*it]);
+		else {
+			for (auto it = minMaxIts.first; it < convexIdx.end(); ++it)
+				convexCurve.push_back(curve[*it]);
+			for (auto it = convexIdx.begin(); it <= minMaxIts.second; ++it)
+				convexCurve.push_back(curve[*it]);
+		}
+		return convexCurve;
+	}
+	return curve;
+}
+
+void TeethModel::findAnglePoints(int const& no) const {
+	if (!anglePointIndices_[no].empty())
+		return;
+	auto const& signVal = 1 - zones_[no] % 2 * 2;
+	auto const& deltaAngle = degreeToRadian(1);
+	auto const& nPoints = contourSizes_[no];
+	auto const& contour = points_.data() + contourOffsets_[no];
+	auto const& centroid = centroids_[no];
+	Point2f directions[360];
+	float targetAngle;
+	if (signVal == 1)
+		targetAngle = CV_PI / 2;
+	else
+		targetAngle = CV_PI / 2 * 3 - deltaAngle;
+	for (auto ray = 0; ray < 360; ++ray) {
+		directions[ray] = rotate(normalDirections_[no], targetAngle);
+		targetAngle -= deltaAngle;
+	}
+	vector<Point> points;
+	vector<int> nextIndices, edgeIndices;
+	points.reserve(nPoints + 360);
+	nextIndices.reserve(nPoints + 360);
+	edgeIndices.reserve(nPoints + 360);
+	for (auto i = 0; i < nPoints; ++i) {
+		points.push_back(contour[i]);
+		nextIndices.push_back((i + 1) % nPoints);
+		edgeIndices.push_back(i);
+	}
+	auto const& startAngle = atan2(directions[0].y, directions[0].x);
+	auto isIndexed = false;
+	vector<int> rayEdges[360];
+	auto const& computeSweep = [&](Point const& point) { return startAngle - atan2(point.y - centroid.y, point.x - centroid.x); };
+	auto const& indexSegment = [&](Point const& p1, Point const& p2, double const& sweep1, double const& sweep2, int const& edge, int const& firstRay) {
+		auto const& v1 = static_cast<Point2d>(p1) - static_cast<Point2d>(centroid);
+		auto const& edgeVector = static_cast<Point2d>(p2 - p1);
+		auto const& lengthSquared = edgeVector.dot(edgeVector);
+		auto const& nearestPoint = v1 + (lengthSquared ? min(max(-v1.dot(edgeVector) / lengthSquared, 0.), 1.) : 0.) * edgeVector;
+		auto firstCoveredRay = 0, lastCoveredRay = 359;
+		if (nearestPoint.dot(nearestPoint) >= 9) {
+			auto const& thisSweep2 = sweep1 + remainder(sweep2 - sweep1, CV_2PI);
+			firstCoveredRay = static_cast<int>(floor(min(sweep1, thisSweep2) / deltaAngle)) - 1;
+			lastCoveredRay = static_cast<int>(ceil(max(sweep1, thisSweep2) / deltaAngle)) + 1;
+			if (lastCoveredRay - firstCoveredRay >= 360) {
+				firstCoveredRay = 0;
+				lastCoveredRay = 359;
+			}
+		}
+		for (auto ray = firstCoveredRay; ray <= lastCoveredRay; ++ray) {
+			auto const& thisRay = (ray % 360 + 360) % 360;
+			auto& edges = rayEdges[thisRay];
+			if (thisRay >= firstRay)
+				edges.insert(upper_bound(edges.begin(), edges.end(), edge), edge);
+		}
+	};
+	int anglePointIndices[360]{};
+	auto index = 0;
+	auto const& hitsRay = [&](int const& ray, int const& thisIndex) {
+		auto const& d = directions[ray];
+		auto const& nextIndex = nextIndices[thisIndex];
+		auto const& p1 = points[thisIndex];
+		auto const& p2 = points[nextIndex];
+		auto const& t = d.cross(centroid - static_cast<Point2f>(p1)) / d.cross(p2 - p1);
+		if (t >= 0 && t < 1) {
+			auto const& point = p1 + t * (p2 - p1);
+			if (d.dot(static_cast<Point2f>(point) - centroid) > 0) {
+				auto& anglePointIndex = anglePointIndices[ray];
+				if (point == p1)
+					anglePointIndex = thisIndex;
+				else if (point == p2)
+					anglePointIndex = nextIndex;
+				else {
+					auto const& edge = edgeIndices[thisIndex];
+					if (isIndexed) {
+						auto const& sweep1 = computeSweep(p1);
+						auto const& sweep = computeSweep(point);
+						auto const& sweep2 = computeSweep(p2);
+						indexSegment(p1, point, sweep1, sweep, edge, ray + 1);
+						indexSegment(point, p2, sweep, sweep2, edge, ray + 1);
+					}
+					anglePointIndex = points.size();
+					points.push_back(point);
+					nextIndices.push_back(nextIndex);
+					edgeIndices.push_back(edge);
+					nextIndices[thisIndex] = anglePointIndex;
+				}
+				index = thisIndex;
+				return true;
+			}
+		}
+		return false;
+	};
+	auto const& walk = [&](int const& ray, int const& startIndex, int const& nSteps) {
+		auto thisIndex = startIndex;
+		for (auto step = 0; step < nSteps; ++step, thisIndex = nextIndices[thisIndex])
+			if (hitsRay(ray, thisIndex))
+				return true;
+		return false;
+	};
+	auto const& searchIndex = [&](int const& ray) {
+		auto const& edges = rayEdges[ray];
+		auto const& nEdges = static_cast<int>(edges.size());
+		auto const& startIndex = index;
+		auto const& startEdge = edgeIndices[startIndex];
+		auto const& firstEdge = static_cast<int>(lower_bound(edges.begin(), edges.end(), startEdge) - edges.begin());
+		for (auto i = 0; i < nEdges; ++i) {
+			auto const& edge = edges[(firstEdge + i) % nEdges];
+			if (i && edge == edges[(firstEdge + i - 1) % nEdges])
+				continue;
+			for (auto thisIndex = edge == startEdge ? startIndex : edge; thisIndex != (edge + 1) % nPoints; thisIndex = nextIndices[thisIndex])
+				if (hitsRay(ray, thisIndex))
+					return true;
+		}
+		if (firstEdge < nEdges && edges[firstEdge] == startEdge)
+			for (auto thisIndex = startEdge; thisIndex != startIndex; thisIndex = nextIndices[thisIndex])
+				if (hitsRay(ray, thisIndex))
+					return true;
+		return false;
+	};
+	auto const& nWalkSteps = nPoints / 180 + 16;
+	for (auto ray = 0; ray < 360; ++ray) {
+		if (!isIndexed && walk(ray, index, ray ? nWalkSteps : nPoints))
+			continue;
+		if (!isIndexed) {
+			auto i = 0;
+			auto sweep = computeSweep(points[i]);
+			do {
+				auto const& nextSweep = computeSweep(points[nextIndices[i]]);
+				indexSegment(points[i], points[nextIndices[i]], sweep, nextSweep, edgeIndices[i], ray);
+				sweep = nextSweep;
+				i = nextIndices[i];
+			} while (i);
+			isIndexed = true;
+		}
+		if (!searchIndex(ray))
+			walk(ray, index, points.size());
+	}
+	vector<int> pointIndices(points.size());
+	auto const& contourOffset = static_cast<int>(points_.size());
+	auto i = 0;
+	do {
+		pointIndices[i] = points_.size() - contourOffset;
+		points_.push_back(points[i]);
+		i = nextIndices[i];
+	} while (i);
+	auto& thisAnglePointIndices = anglePointIndices_[no];
+	thisAnglePointIndices.resize(360);
+	for (auto ray = 0; ray < 360; ++ray)
+		thisAnglePointIndices[signVal == 1 ? ray : 359 - ray] = pointIndices[anglePointIndices[ray]];
+	contourOffsets_[no] = contourOffset;
+	contourSizes_[no] = points_.size() - contourOffset;
+}
+
+void TeethModel::bindTeeth() {
+	auto nPoints = points_.size();
+	for (auto no = 0; no < size(); ++no) {
+		if (no == teeth_.size())
+			teeth_.push_back(Tooth(this, no));
+		teeth_[no].teethModel_ = this;
+		if (anglePointIndices_[no].empty())
+			nPoints += contourSizes_[no] + 360;
+	}
+	points_.reserve(nPoints);
+}
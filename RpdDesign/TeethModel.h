@@ -0,0 +1,48 @@
+#pragma once
+
+#include <iosfwd>
+
+#include "Tooth.h"
+
+class TeethModel {
+public:
+	TeethModel() = default;
+	TeethModel(TeethModel const& teethModel);
+	TeethModel(TeethModel&& teethModel);
+	explicit TeethModel(istream& stream);
+	TeethModel(vector<vector<Point>> const& contours, vector<int> const& zones, vector<Point2f> const& normalDirections);
+	TeethModel(vector<Point> const& points, vector<int> const& contourOffsets, vector<int> const& zones, vector<float> const& radii, vector<Point2f> const& centroids, vector<Point2f> const& normalDirections, vector<int> const& anglePointIndices);
+	TeethModel& operator=(TeethModel const& teethModel);
+	TeethModel& operator=(TeethModel&& teethModel);
+	Tooth* operator[](int const& zone);
+	Tooth const* operator[](int const& zone) const;
+	Tooth* begin();
+	Tooth const* begin() const;
+	Tooth* end();
+	Tooth const* end() const;
+	int size() const;
+	void addReadFlags(ToothFlag const& flag, uint32_t const& mask) const;
+	uint32_t getFlags(ToothFlag const& flag, uint32_t const& mask = ~0U) const;
+	uint32_t const& getReadFlags(ToothFlag const& flag) const;
+	uint32_t peekFlags(ToothFlag const& flag, uint32_t const& mask = ~0U) const;
+	void setFlags(ToothFlag const& flag, uint32_t const& mask);
+	void unsetFlags();
+	void unsetReadFlags() const;
+	void write(ostream& stream) const;
+private:
+	friend class Tooth;
+	vector<Point> const& getCurve(int const& no, int const& startAngle, int const& endAngle, bool const& isConvex) const;
+	vector<Point> computeCurve(int const& no, int const& startAngle, int const& endAngle, bool const& isConvex) const;
+	void findAnglePoints(int const& no) const;
+	void bindTeeth();
+	vector<float> radii_;
+	vector<int> zones_;
+	vector<Point2f> centroids_, normalDirections_;
+	vector<Tooth> teeth_;
+	mutable vector<int> contourOffsets_, contourSizes_;
+	mutable vector<Point> points_;
+	mutable vector<vector<int>> anglePointIndices_;
+	mutable map<int, vector<Point>> curves_;
+	uint32_t flags_[SINGLE_SIDED_DENTURE_BASE + 1]{};
+	mutable uint32_t readFlags_[SINGLE_SIDED_DENTURE_BASE + 1]{};
+};
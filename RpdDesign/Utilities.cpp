@@ -1,51 +1,86 @@
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
+﻿#include <istream>
 #include <opencv2/imgproc.hpp>
 
 #include "Utilities.h"
-#include "EllipticCurve.h"
-#include "Tooth.h"
+#include "DesignGraph.h"
+#include "DesignSpec.h"
+#include "DisplayList.h"
+#include "FilletCurve.h"
+#include "OwlReader.h"
+#include "TeethModel.h"
 
 float degreeToRadian(float const& degree) { return degree / 180 * CV_PI; }
 
 float radianToDegree(float const& radian) { return radian / CV_PI * 180; }
 
-void catPath(string& path, string const& searchDirectory, string const& extension) {
-	auto const& searchPattern = searchDirectory + extension;
-	WIN32_FIND_DATA findData;
-	auto const& hFind = FindFirstFile(searchPattern.c_str(), &findData);
-	do
-		if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
-			path.append(searchDirectory + findData.cFileName + ';');
-	while (FindNextFile(hFind, &findData));
-	FindClose(hFind);
-}
-
 string getClsSig(const char* const& clsStr) { return 'L' + string(clsStr) + ';'; }
 
+streamoff computeRemainingSize(istream& stream) {
+	auto const& position = stream.tellg();
+	stream.seekg(0, ios::end);
+	auto const& size = stream.tellg() - position;
+	stream.seekg(position);
+	return stream ? size : 0;
+}
+
 Rpd::Direction operator~(Rpd::Direction const& direction) { return direction == Rpd::MESIAL ? Rpd::DISTAL : Rpd::MESIAL; }
 
-Tooth const& getTooth(const vector<Tooth> (&teeth)[nZones], Rpd::Position const& position) { return teeth[position.zone][position.ordinal]; }
+Tooth const& getTooth(TeethModel const& teeth, Rpd::Position const& position) { return teeth[position.zone][position.ordinal]; }
 
-Tooth& getTooth(vector<Tooth> (&teeth)[nZones], Rpd::Position const& position) { return const_cast<Tooth&>(getTooth(const_cast<const vector<Tooth>(&)[nZones]>(teeth), position)); }
+Tooth& getTooth(TeethModel& teeth, Rpd::Position const& position) { return const_cast<Tooth&>(getTooth(const_cast<TeethModel const&>(teeth), position)); }
 
-bool isBlockedByMajorConnector(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions) {
-	if (positions[0].zone == positions[1].zone) {
-		for (auto position = positions[0]; position <= positions[1]; ++position)
-			if (getTooth(teeth, position).hasMajorConnector())
-				return true;
-		return false;
-	}
-	return isBlockedByMajorConnector(teeth, {Rpd::Position(positions[0].zone, 0), positions[0]}) || isBlockedByMajorConnector(teeth, {Rpd::Position(positions[1].zone, 0), positions[1]});
+int computeArchIndex(Rpd::Position const& position) { return position.zone / 2 * nTeethPerZone * 2 + (position.zone % 2 ? nTeethPerZone + position.ordinal : nTeethPerZone - 1 - position.ordinal); }
+
+uint32_t computeArchMask(Rpd::Position const& startPosition, Rpd::Position const& endPosition) {
+	if (startPosition.zone != endPosition.zone)
+		return computeArchMask(Rpd::Position(startPosition.zone, 0), startPosition) | computeArchMask(Rpd::Position(endPosition.zone, 0), endPosition);
+	if (startPosition.ordinal > endPosition.ordinal)
+		return 0;
+	auto const& archIndices = minmax(computeArchIndex(startPosition), computeArchIndex(endPosition));
+	return ~0U >> (31 - archIndices.second) & ~0U << archIndices.first;
 }
 
-void computeStringCurves(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, vector<vector<Point>>& curves, float* const& sumOfRadii, int* const& nTeeth, vector<Point>* const& distalPoints) {
-	auto thisNTeeth = 0;
+bool isBlockedByMajorConnector(TeethModel const& teeth, vector<Rpd::Position> const& positions) { return teeth.getFlags(MAJOR_CONNECTOR, computeArchMask(positions[0], positions[1])) != 0; }
+
+void computeStringCurves(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, vector<vector<Point>>& curves, float* const& sumOfRadii, int* const& nTeeth, vector<Point>* const& distalPoints) {
+	auto const& curveCache = context.curveCache && context.curveCache->isEnabled() ? context.curveCache : nullptr;
+	auto const& key = curveCache ? CurveCache::computeKey(positions, distanceScales, keepStartEndPoints, considerAnchorDisplacements, considerDistalPoints, sumOfRadii ? *sumOfRadii : 0, nTeeth ? *nTeeth : 0) : vector<uint32_t>();
+	auto stringCurves = curveCache ? curveCache->find(teeth, key) : nullptr;
+	if (!stringCurves) {
+		auto const& thisStringCurves = make_shared<CurveCache::StringCurves>();
+		thisStringCurves->sumOfRadii = sumOfRadii ? *sumOfRadii : 0;
+		thisStringCurves->nTeeth = nTeeth ? *nTeeth : 0;
+		if (curveCache) {
+			uint32_t lastReadFlags[SINGLE_SIDED_DENTURE_BASE + 1];
+			for (auto flag = 0; flag <= SINGLE_SIDED_DENTURE_BASE; ++flag)
+				lastReadFlags[flag] = teeth.getReadFlags(static_cast<ToothFlag>(flag));
+			teeth.unsetReadFlags();
+			computeStringCurves(context, teeth, positions, distanceScales, keepStartEndPoints, considerAnchorDisplacements, considerDistalPoints, *thisStringCurves);
+			for (auto flag = 0; flag <= SINGLE_SIDED_DENTURE_BASE; ++flag) {
+				thisStringCurves->readFlags[flag] = teeth.getReadFlags(static_cast<ToothFlag>(flag));
+				thisStringCurves->flags[flag] = teeth.peekFlags(static_cast<ToothFlag>(flag), thisStringCurves->readFlags[flag]);
+				teeth.addReadFlags(static_cast<ToothFlag>(flag), lastReadFlags[flag]);
+			}
+			curveCache->insert(key, thisStringCurves);
+		}
+		else
+			computeStringCurves(context, teeth, positions, distanceScales, keepStartEndPoints, considerAnchorDisplacements, considerDistalPoints, *thisStringCurves);
+		stringCurves = thisStringCurves;
+	}
+	curves = stringCurves->curves;
 	if (nTeeth)
-		thisNTeeth = *nTeeth;
-	float thisSumOfRadii = 0;
+		*nTeeth = stringCurves->nTeeth;
 	if (sumOfRadii)
-		thisSumOfRadii = *sumOfRadii;
+		*sumOfRadii = stringCurves->sumOfRadii;
+	if (distalPoints)
+		for (auto i = 0; i < 2; ++i)
+			if (stringCurves->hasDistalPoints[i])
+				(*distalPoints)[i] = stringCurves->distalPoints[i];
+}
+
+void computeStringCurves(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, CurveCache::StringCurves& stringCurves) {
+	auto thisNTeeth = stringCurves.nTeeth;
+	auto thisSumOfRadii = stringCurves.sumOfRadii;
 	vector<Point> curve;
 	if (positions[0].zone == positions[1].zone) {
 		Point lastPoint;
@@ -63,131 +98,118 @@ void computeStringCurves(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Posit
 			auto const& position = --Rpd::Position(positions[0]);
 			auto& tooth = getTooth(teeth, position);
 			if (positions[0].ordinal) {
-				if (tooth.expectMajorConnectorAnchor(Rpd::MESIAL) && !shouldAnchor(teeth, position, Rpd::MESIAL))
+				if (tooth.expectMajorConnectorAnchor(Rpd::MESIAL) && !shouldAnchor(context, teeth, position, Rpd::MESIAL))
 					curve[0] = tooth.getAnglePoint(180);
 			}
-			else if (tooth.expectMajorConnectorAnchor(Rpd::DISTAL) && !shouldAnchor(teeth, position, Rpd::DISTAL))
+			else if (tooth.expectMajorConnectorAnchor(Rpd::DISTAL) && !shouldAnchor(context, teeth, position, Rpd::DISTAL))
 				curve[0] = tooth.getAnglePoint(0);
 		}
-		if (considerAnchorDisplacements[1] && !isLastTooth(positions[1])) {
+		if (considerAnchorDisplacements[1] && !isLastTooth(context, positions[1])) {
 			auto const& position = ++Rpd::Position(positions[1]);
 			auto& tooth = getTooth(teeth, position);
-			if (tooth.expectMajorConnectorAnchor(Rpd::DISTAL) && !shouldAnchor(teeth, position, Rpd::DISTAL))
+			if (tooth.expectMajorConnectorAnchor(Rpd::DISTAL) && !shouldAnchor(context, teeth, position, Rpd::DISTAL))
 				curve.back() = tooth.getAnglePoint(0);
 		}
 	}
 	else {
 		vector<vector<Point>> tmpCurves(2);
 		for (auto i = 0; i < 2; ++i)
-			computeStringCurve(teeth, {Rpd::Position(positions[i].zone, 0), positions[i]}, 0, {false, false}, {false, considerAnchorDisplacements[i]}, false, tmpCurves[i], &thisSumOfRadii, &thisNTeeth);
+			computeStringCurve(context, teeth, {Rpd::Position(positions[i].zone, 0), positions[i]}, 0, {false, false}, {false, considerAnchorDisplacements[i]}, false, tmpCurves[i], &thisSumOfRadii, &thisNTeeth);
 		tmpCurves[0][0] = (tmpCurves[0][0] + tmpCurves[1][0]) / 2;
 		tmpCurves[1].erase(tmpCurves[1].begin());
 		tmpCurves[1].insert(tmpCurves[1].begin(), tmpCurves[0].rbegin(), tmpCurves[0].rend());
 		curve = tmpCurves[1];
 	}
-	if (nTeeth)
-		*nTeeth = thisNTeeth;
-	if (sumOfRadii)
-		*sumOfRadii = thisSumOfRadii;
+	stringCurves.nTeeth = thisNTeeth;
+	stringCurves.sumOfRadii = thisSumOfRadii;
 	auto thisAvgRadius = thisSumOfRadii / thisNTeeth;
 	if (considerDistalPoints) {
-		if (positions[0].zone != positions[1].zone && isLastTooth(positions[0])) {
+		if (positions[0].zone != positions[1].zone && isLastTooth(context, positions[0])) {
 			auto& tmpPoint = getTooth(teeth, positions[0]).getAnglePoint(180);
-			curve.insert(curve.begin(), tmpPoint + roundToPoint(rotate(computeNormalDirection(tmpPoint), -CV_PI / 2) * thisAvgRadius * 0.6F));
-			if (distalPoints)
-				(*distalPoints)[0] = curve[0];
+			curve.insert(curve.begin(), tmpPoint + roundToPoint(rotate(computeNormalDirection(context, tmpPoint), -CV_PI / 2) * thisAvgRadius * 0.6F));
+			stringCurves.distalPoints[0] = curve[0];
+			stringCurves.hasDistalPoints[0] = true;
 		}
-		if (isLastTooth(positions[1])) {
+		if (isLastTooth(context, positions[1])) {
 			auto& tmpPoint = getTooth(teeth, positions[1]).getAnglePoint(180);
-			curve.push_back(tmpPoint + roundToPoint(rotate(computeNormalDirection(tmpPoint), CV_PI * (positions[1].zone % 2 - 0.5)) * thisAvgRadius * 0.6F));
-			if (distalPoints)
-				(*distalPoints)[1] = curve.back();
-		}
-	}
-	curves.clear();
-	for (auto i = 0; i < distanceScales.size(); ++i)
-		curves.push_back(curve);
-	for (auto i = 0; i < curve.size(); ++i) {
-		auto delta = computeNormalDirection(curve[i]) * thisAvgRadius;
-		for (auto j = 0; j < distanceScales.size(); ++j)
-			curves[j][i] += roundToPoint(delta * distanceScales[j]);
-		if (i == 0 && keepStartEndPoints[0]) {
-			for (auto j = 0; j < distanceScales.size(); ++j)
-				curves[j].insert(curves[j].begin(), curve[0]);
-			curve.insert(curve.begin(), curve[0]);
-			++i;
-		}
-		else if (i == curve.size() - 1 && keepStartEndPoints[1]) {
-			for (auto j = 0; j < distanceScales.size(); ++j)
-				curves[j].push_back(curve.back());
-			curve.push_back(curve.back());
-			++i;
+			curve.push_back(tmpPoint + roundToPoint(rotate(computeNormalDirection(context, tmpPoint), CV_PI * (positions[1].zone % 2 - 0.5)) * thisAvgRadius * 0.6F));
+			stringCurves.distalPoints[1] = curve.back();
+			stringCurves.hasDistalPoints[1] = true;
 		}
 	}
+	computeOffsetCurves(context, curve, thisAvgRadius, distanceScales, keepStartEndPoints, stringCurves.curves);
 }
 
-void computeStringCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, float const& distanceScale, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, vector<Point>& curve, float* const& sumOfRadii, int* const& nTeeth, vector<Point>* const& distalPoints) {
+void computeStringCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, float const& distanceScale, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, vector<Point>& curve, float* const& sumOfRadii, int* const& nTeeth, vector<Point>* const& distalPoints) {
 	vector<vector<Point>> tmpCurves;
-	computeStringCurves(teeth, positions, {distanceScale}, keepStartEndPoints, considerAnchorDisplacements, considerDistalPoints, tmpCurves, sumOfRadii, nTeeth, distalPoints);
-	curve = tmpCurves[0];
+	computeStringCurves(context, teeth, positions, {distanceScale}, keepStartEndPoints, considerAnchorDisplacements, considerDistalPoints, tmpCurves, sumOfRadii, nTeeth, distalPoints);
+	curve = move(tmpCurves[0]);
 }
 
-void computeInscribedCurve(vector<Point> const& cornerPoints, vector<Point>& curve, float const& smoothness, bool const& shouldAppend) {
-	Point2f const &v1 = cornerPoints[0] - cornerPoints[1], &v2 = cornerPoints[2] - cornerPoints[1];
-	auto const &l1 = norm(v1), &l2 = norm(v2);
-	auto const &d1 = v1 / l1, &d2 = v2 / l2;
-	auto const& sinTheta = d1.cross(d2);
-	auto theta = asin(abs(sinTheta));
-	if (d1.dot(d2) < 0)
-		theta = CV_PI - theta;
-	auto const& radius = static_cast<float>(min({l1, l2}) * tan(theta / 2) * smoothness);
-	vector<Point> thisCurve;
-	auto const& d = sinTheta < 0 ? d1 : d2;
-	auto const& isValidCurve = EllipticCurve(cornerPoints[1] + roundToPoint(normalize(d1 + d2) * radius / sin(theta / 2)), Size(radius, radius), radianToDegree(atan2(d.x, -d.y)), 180 - radianToDegree(theta), sinTheta > 0).getCurve(thisCurve);
+void computeInscribedCurve(DesignContext const& context, vector<Point> const& cornerPoints, vector<Point>& curve, float const& smoothness, bool const& shouldAppend) {
+	FilletCurve const filletCurve(context, cornerPoints[0], cornerPoints[1], cornerPoints[2], smoothness);
 	if (!shouldAppend)
 		curve.clear();
-	if (isValidCurve)
-		curve.insert(curve.end(), thisCurve.begin(), thisCurve.end());
-	else
-		curve.push_back(cornerPoints[1]);
+	auto const& nPoints = curve.size();
+	curve.resize(nPoints + filletCurve.getMaxSize());
+	curve.resize(filletCurve.getCurve(curve.data() + nPoints) - curve.data());
 }
 
-void computeSmoothCurve(vector<Point> const& curve, vector<Point>& smoothCurve, bool const& isClosed, float const& smoothness) {
-	vector<Point> tmpCurve;
+void computeSmoothCurve(DesignContext const& context, vector<Point> const& curve, vector<Point>& smoothCurve, bool const& isClosed, float const& smoothness) {
+	vector<FilletCurve> filletCurves;
+	filletCurves.reserve(curve.size());
+	auto nPoints = 0;
 	for (auto point = curve.begin(); point < curve.end(); ++point) {
 		auto const &isFirst = point == curve.begin(), &isLast = point == curve.end() - 1;
-		if (isClosed || !(isFirst || isLast))
-			computeInscribedCurve({isFirst ? curve.back() : *(point - 1), *point, isLast ? curve[0] : *(point + 1)}, tmpCurve, smoothness);
+		if (isClosed || !(isFirst || isLast)) {
+			filletCurves.emplace_back(context, isFirst ? curve.back() : *(point - 1), *point, isLast ? curve[0] : *(point + 1), smoothness);
+			nPoints += filletCurves.back().getMaxSize();
+		}
 		else
-			tmpCurve.insert(tmpCurve.end(), *point);
+			++nPoints;
 	}
-	smoothCurve = tmpCurve;
+	vector<Point> tmpCurve(nPoints);
+	auto thisPoint = tmpCurve.data();
+	auto filletCurve = filletCurves.begin();
+	for (auto point = curve.begin(); point < curve.end(); ++point)
+		if (isClosed || !(point == curve.begin() || point == curve.end() - 1))
+			thisPoint = filletCurve++->getCurve(thisPoint);
+		else
+			*thisPoint++ = *point;
+	tmpCurve.resize(thisPoint - tmpCurve.data());
+	smoothCurve = move(tmpCurve);
 }
 
-void computePiecewiseSmoothCurve(vector<Point> const& curve, vector<Point>& piecewiseSmoothCurve, bool const& smoothStart, bool const& smoothEnd) {
-	vector<vector<Point>> smoothCurves(3);
-	smoothCurves[1] = vector<Point>{curve.begin() + 2, curve.end() - 2};
+void computePiecewiseSmoothCurve(DesignContext const& context, vector<Point> const& curve, vector<Point>& piecewiseSmoothCurve, bool const& smoothStart, bool const& smoothEnd) {
+	FilletCurve const startFilletCurve(context, curve[0], curve[1], curve[2], 1), endFilletCurve(context, *(curve.end() - 3), *(curve.end() - 2), curve.back(), 1);
+	vector<Point> smoothCurve;
+	smoothCurve.reserve(curve.size());
+	if (smoothStart)
+		smoothCurve.push_back(startFilletCurve.getEndPoint());
+	else
+		smoothCurve.insert(smoothCurve.end(), curve.begin(), curve.begin() + 2);
+	smoothCurve.insert(smoothCurve.end(), curve.begin() + 2, curve.end() - 2);
+	if (smoothEnd)
+		smoothCurve.push_back(endFilletCurve.getStartPoint());
+	else
+		smoothCurve.insert(smoothCurve.end(), curve.end() - 2, curve.end());
+	computeSmoothCurve(context, smoothCurve, smoothCurve);
+	vector<Point> tmpCurve(smoothCurve.size() + (smoothStart ? startFilletCurve.getMaxSize() + 1 : 0) + (smoothEnd ? endFilletCurve.getMaxSize() + 1 : 0));
+	auto thisPoint = tmpCurve.data();
 	if (smoothStart) {
-		computeInscribedCurve(vector<Point>{curve.begin(), curve.begin() + 3}, smoothCurves[0], 1);
-		smoothCurves[0].insert(smoothCurves[0].begin(), curve[0]);
-		smoothCurves[1].insert(smoothCurves[1].begin(), smoothCurves[0].back());
+		*thisPoint++ = curve[0];
+		thisPoint = startFilletCurve.getCurve(thisPoint);
 	}
-	else
-		smoothCurves[1].insert(smoothCurves[1].begin(), curve.begin(), curve.begin() + 2);
+	thisPoint = copy(smoothCurve.begin(), smoothCurve.end(), thisPoint);
 	if (smoothEnd) {
-		computeInscribedCurve(vector<Point>{curve.end() - 3, curve.end()}, smoothCurves[2], 1);
-		smoothCurves[2].push_back(curve.back());
-		smoothCurves[1].push_back(smoothCurves[2][0]);
+		thisPoint = endFilletCurve.getCurve(thisPoint);
+		*thisPoint++ = curve.back();
 	}
-	else
-		smoothCurves[1].insert(smoothCurves[1].end(), curve.end() - 2, curve.end());
-	computeSmoothCurve(smoothCurves[1], smoothCurves[1]);
-	piecewiseSmoothCurve.clear();
-	for (auto i = 0; i < 3; ++i)
-		piecewiseSmoothCurve.insert(piecewiseSmoothCurve.end(), smoothCurves[i].begin(), smoothCurves[i].end());
+	tmpCurve.resize(thisPoint - tmpCurve.data());
+	piecewiseSmoothCurve = move(tmpCurve);
 }
 
-void findAnchorPoints(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Rpd::Position>& startEndPositions, const vector<Point>* const& inAnchorPoints, vector<Point>* const& outAnchorPoints) {
+void findAnchorPoints(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Rpd::Position>& startEndPositions, const vector<Point>* const& inAnchorPoints, vector<Point>* const& outAnchorPoints) {
 	startEndPositions = positions;
 	vector<Point> anchorPoints;
 	if (inAnchorPoints)
@@ -195,12 +217,12 @@ void findAnchorPoints(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position
 	else {
 		anchorPoints = vector<Point>(2);
 		if (startEndPositions[0].zone == startEndPositions[1].zone) {
-			if (!shouldAnchor(teeth, startEndPositions[0], Rpd::MESIAL))
+			if (!shouldAnchor(context, teeth, startEndPositions[0], Rpd::MESIAL))
 				anchorPoints[0] = getTooth(teeth, startEndPositions[0]++).getAnglePoint(180);
 		}
-		else if (!shouldAnchor(teeth, startEndPositions[0], Rpd::DISTAL))
+		else if (!shouldAnchor(context, teeth, startEndPositions[0], Rpd::DISTAL))
 			anchorPoints[0] = getTooth(teeth, startEndPositions[0]--).getAnglePoint(0);
-		if (!shouldAnchor(teeth, startEndPositions[1], Rpd::DISTAL)) {
+		if (!shouldAnchor(context, teeth, startEndPositions[1], Rpd::DISTAL)) {
 			auto const& shouldSwap = startEndPositions[1].ordinal == 0;
 			anchorPoints[1] = getTooth(teeth, startEndPositions[1]--).getAnglePoint(0);
 			if (shouldSwap) {
@@ -213,13 +235,13 @@ void findAnchorPoints(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position
 		*outAnchorPoints = anchorPoints;
 }
 
-void computeLingualCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve, vector<vector<Point>>& curves, vector<Point>* const& distalPoints, const vector<Point>* const& anchorPoints) {
+void computeLingualCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve, vector<vector<Point>>& curves, vector<Point>* const& distalPoints, const vector<Point>* const& anchorPoints) {
 	curve.clear();
 	if (distalPoints)
 		*distalPoints = vector<Point>(2);
 	vector<Rpd::Position> startEndPositions;
 	vector<Point> thisAnchorPoints;
-	findAnchorPoints(teeth, positions, startEndPositions, anchorPoints, &thisAnchorPoints);
+	findAnchorPoints(context, teeth, positions, startEndPositions, anchorPoints, &thisAnchorPoints);
 	if (startEndPositions[0].zone == startEndPositions[1].zone) {
 		auto dbStartPosition = startEndPositions[0];
 		while (dbStartPosition <= startEndPositions[1] && !getTooth(teeth, dbStartPosition).hasDentureBase(DentureBase::DOUBLE))
@@ -236,14 +258,14 @@ void computeLingualCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Posit
 			vector<Point> thisCurve;
 			if (considerLast || hasDistalLingualCoverage) {
 				auto const& lastPosition = --Rpd::Position(position);
-				computeStringCurve(teeth, {considerLast ? lastPosition : position, hasDistalLingualCoverage ? position : lastPosition}, -distanceScales[BYPASS], {true, true}, {false, false}, false, thisCurve);
-				computePiecewiseSmoothCurve(thisCurve, thisCurve);
+				computeStringCurve(context, teeth, {considerLast ? lastPosition : position, hasDistalLingualCoverage ? position : lastPosition}, -distanceScales[BYPASS], {true, true}, {false, false}, false, thisCurve);
+				computePiecewiseSmoothCurve(context, thisCurve, thisCurve);
 				curves.push_back(thisCurve);
 				curve.insert(curve.end(), thisCurve.begin(), thisCurve.end());
 			}
 			if (isValidPosition && !hasMesialLingualCoverage && !hasDistalLingualCoverage) {
-				thisCurve = getTooth(teeth, position).getCurve(180, 0);
-				curve.insert(curve.end(), thisCurve.rbegin(), thisCurve.rend());
+				auto const& toothCurve = getTooth(teeth, position).getCurve(180, 0);
+				curve.insert(curve.end(), toothCurve.rbegin(), toothCurve.rend());
 			}
 			considerLast = hasMesialLingualCoverage;
 		}
@@ -253,50 +275,50 @@ void computeLingualCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Posit
 			curve.push_back(thisAnchorPoints[1]);
 		else if (dbStartPosition <= startEndPositions[1]) {
 			vector<Point> dbCurve;
-			computeStringCurve(teeth, {dbStartPosition, startEndPositions[1]}, -distanceScales[DENTURE_BASE_CURVE], {true, true}, {true, true}, true, dbCurve, nullptr, nullptr, distalPoints);
-			computePiecewiseSmoothCurve(dbCurve, dbCurve);
+			computeStringCurve(context, teeth, {dbStartPosition, startEndPositions[1]}, -distanceScales[DENTURE_BASE_CURVE], {true, true}, {true, true}, true, dbCurve, nullptr, nullptr, distalPoints);
+			computePiecewiseSmoothCurve(context, dbCurve, dbCurve);
 			curve.insert(curve.end(), dbCurve.begin(), dbCurve.end());
 		}
 	}
 	else {
 		vector<int> const& zones{startEndPositions[0].zone, startEndPositions[1].zone};
 		vector<Rpd::Position> const& startPositions{Rpd::Position(zones[0], 0), Rpd::Position(zones[1], 0)};
-		vector<Tooth> const& startTeeth{getTooth(teeth, startPositions[0]), getTooth(teeth, startPositions[1])};
+		Tooth const* const startTeeth[]{&getTooth(teeth, startPositions[0]), &getTooth(teeth, startPositions[1])};
 		vector<vector<Point>> tmpCurves(2);
 		vector<Point> tmpDistalPoints(2);
-		if (startTeeth[0].hasDentureBase(DentureBase::DOUBLE) && startTeeth[1].hasDentureBase(DentureBase::DOUBLE)) {
+		if (startTeeth[0]->hasDentureBase(DentureBase::DOUBLE) && startTeeth[1]->hasDentureBase(DentureBase::DOUBLE)) {
 			auto dbPositions = startPositions;
 			for (auto i = 0; i < 2; ++i) {
 				while (getTooth(teeth, ++Rpd::Position(dbPositions[i])).hasDentureBase(DentureBase::DOUBLE))
 					++dbPositions[i];
-				computeLingualCurve(teeth, {++Rpd::Position(dbPositions[i]), startEndPositions[i]}, tmpCurves[i], curves, &tmpDistalPoints, new vector<Point>{Point(), thisAnchorPoints[i]});
+				computeLingualCurve(context, teeth, {++Rpd::Position(dbPositions[i]), startEndPositions[i]}, tmpCurves[i], curves, &tmpDistalPoints, new vector<Point>{Point(), thisAnchorPoints[i]});
 				if (distalPoints && tmpDistalPoints[1] != Point())
 					(*distalPoints)[i] = tmpDistalPoints[1];
 			}
-			computeStringCurve(teeth, {dbPositions[0], dbPositions[1]}, -distanceScales[DENTURE_BASE_CURVE], {true, true}, {true, true}, true, curve, nullptr, nullptr, &tmpDistalPoints);
+			computeStringCurve(context, teeth, {dbPositions[0], dbPositions[1]}, -distanceScales[DENTURE_BASE_CURVE], {true, true}, {true, true}, true, curve, nullptr, nullptr, &tmpDistalPoints);
 			if (distalPoints)
 				for (auto i = 0; i < 2; ++i)
 					if (tmpDistalPoints[i] != Point())
 						(*distalPoints)[i] = tmpDistalPoints[i];
-			computePiecewiseSmoothCurve(curve, curve);
+			computePiecewiseSmoothCurve(context, curve, curve);
 			curve.insert(curve.begin(), tmpCurves[0].rbegin(), tmpCurves[0].rend());
 			curve.insert(curve.end(), tmpCurves[1].begin(), tmpCurves[1].end());
 		}
-		else if (startTeeth[0].hasLingualCoverage(Rpd::DISTAL) && startTeeth[1].hasLingualCoverage(Rpd::DISTAL)) {
+		else if (startTeeth[0]->hasLingualCoverage(Rpd::DISTAL) && startTeeth[1]->hasLingualCoverage(Rpd::DISTAL)) {
 			for (auto i = 0; i < 2; ++i) {
-				computeLingualCurve(teeth, {Rpd::Position(zones[i], 1), startEndPositions[i]}, tmpCurves[i], curves, &tmpDistalPoints, new vector<Point>{Point(), thisAnchorPoints[i]});
+				computeLingualCurve(context, teeth, {Rpd::Position(zones[i], 1), startEndPositions[i]}, tmpCurves[i], curves, &tmpDistalPoints, new vector<Point>{Point(), thisAnchorPoints[i]});
 				if (distalPoints && tmpDistalPoints[1] != Point())
 					(*distalPoints)[i] = tmpDistalPoints[1];
 			}
-			computeStringCurve(teeth, {startPositions[0], startPositions[1]}, -distanceScales[BYPASS], {true, true}, {false, false}, false, curve);
-			computePiecewiseSmoothCurve(curve, curve);
+			computeStringCurve(context, teeth, {startPositions[0], startPositions[1]}, -distanceScales[BYPASS], {true, true}, {false, false}, false, curve);
+			computePiecewiseSmoothCurve(context, curve, curve);
 			curves.push_back(curve);
 			curve.insert(curve.begin(), tmpCurves[0].rbegin(), tmpCurves[0].rend());
 			curve.insert(curve.end(), tmpCurves[1].begin(), tmpCurves[1].end());
 		}
 		else {
 			for (auto i = 0; i < 2; ++i) {
-				computeLingualCurve(teeth, {startPositions[i], startEndPositions[i]}, tmpCurves[i], curves, &tmpDistalPoints, new vector<Point>{Point(), thisAnchorPoints[i]});
+				computeLingualCurve(context, teeth, {startPositions[i], startEndPositions[i]}, tmpCurves[i], curves, &tmpDistalPoints, new vector<Point>{Point(), thisAnchorPoints[i]});
 				if (distalPoints && tmpDistalPoints[1] != Point())
 					(*distalPoints)[i] = tmpDistalPoints[1];
 			}
@@ -306,17 +328,17 @@ void computeLingualCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Posit
 	}
 }
 
-void computeLingualCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve, vector<vector<Point>>& curves, Point& distalPoint, const vector<Point>* const& anchorPoints) {
+void computeLingualCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve, vector<vector<Point>>& curves, Point& distalPoint, const vector<Point>* const& anchorPoints) {
 	vector<Point> distalPoints;
-	computeLingualCurve(teeth, positions, curve, curves, &distalPoints, anchorPoints);
+	computeLingualCurve(context, teeth, positions, curve, curves, &distalPoints, anchorPoints);
 	if (distalPoints.size())
 		distalPoint = distalPoints[1];
 }
 
-void computeMesialCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve, vector<int>& mesialOrdinals, vector<Point>* const& innerCurve) {
+void computeMesialCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve, vector<int>& mesialOrdinals, vector<Point>* const& innerCurve) {
 	auto startPositions = positions;
 	for (auto i = 0; i < 2; ++i)
-		if (!shouldAnchor(teeth, startPositions[i], Rpd::MESIAL))
+		if (!shouldAnchor(context, teeth, startPositions[i], Rpd::MESIAL))
 			++startPositions[i];
 	mesialOrdinals = {startPositions[0].ordinal, startPositions[1].ordinal};
 	auto const& isLevel = startPositions[0].ordinal == startPositions[1].ordinal;
@@ -324,11 +346,14 @@ void computeMesialCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positi
 	float sumOfRadii = 0;
 	auto nTeeth = 0;
 	for (auto i = 0; i < 2; ++i)
-		computeStringCurve(teeth, {startPositions[i], Rpd::Position(positions[i].zone, max(mesialOrdinals[0], mesialOrdinals[1]))}, 0, {true, false}, {true, false}, false, curves[i], &sumOfRadii, &nTeeth);
+		computeStringCurve(context, teeth, {startPositions[i], Rpd::Position(positions[i].zone, max(mesialOrdinals[0], mesialOrdinals[1]))}, 0, {true, false}, {true, false}, false, curves[i], &sumOfRadii, &nTeeth);
 	auto const& avgRadius = sumOfRadii / nTeeth;
-	for (auto i = 0; i < 2; ++i)
-		for (auto point = curves[i].begin() + 1; point < curves[i].end(); ++point)
-			*point -= roundToPoint(computeNormalDirection(*point) * avgRadius * distanceScales[MESIAL_OR_DISTAL]);
+	vector<Point2f> normalDirections;
+	for (auto i = 0; i < 2; ++i) {
+		computeNormalDirections(context, curves[i], normalDirections);
+		for (auto j = 1; j < curves[i].size(); ++j)
+			curves[i][j] -= roundToPoint(normalDirections[j] * avgRadius * distanceScales[MESIAL_OR_DISTAL]);
+	}
 	if (innerCurve) {
 		innerCurve->clear();
 		innerCurve->push_back(curves[0][2]);
@@ -338,13 +363,13 @@ void computeMesialCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positi
 	curve = vector<Point>{curves[0].begin(), curves[0].begin() + 2};
 	curve.push_back((*(curves[0].end() - 3 + isLevel) + *(curves[1].end() - 3 + isLevel)) / 2);
 	curve.insert(curve.end(), curves[1].rend() - 2, curves[1].rend());
-	computeSmoothCurve(curve, curve);
+	computeSmoothCurve(context, curve, curve);
 }
 
-void computeDistalCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point> const& distalPoints, vector<Point>& curve, const vector<int>* const& mesialOrdinals, vector<Point>* const& innerCurve) {
+void computeDistalCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point> const& distalPoints, vector<Point>& curve, const vector<int>* const& mesialOrdinals, vector<Point>* const& innerCurve) {
 	auto endPositions = positions;
 	for (auto i = 0; i < 2; ++i)
-		if (!shouldAnchor(teeth, endPositions[i], Rpd::DISTAL))
+		if (!shouldAnchor(context, teeth, endPositions[i], Rpd::DISTAL))
 			--endPositions[i];
 	auto const& ordinal = min(endPositions[0].ordinal, endPositions[1].ordinal);
 	auto const& hasConflict = mesialOrdinals && ordinal <= max((*mesialOrdinals)[0], (*mesialOrdinals)[1]);
@@ -353,15 +378,18 @@ void computeDistalCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positi
 	float sumOfRadii = 0;
 	auto nTeeth = 0;
 	for (auto i = 0; i < 2; ++i) {
-		computeStringCurve(teeth, {Rpd::Position(positions[i].zone, ordinal), endPositions[i]}, 0, {false, false}, {false, true}, false, curves[i], &sumOfRadii, &nTeeth);
+		computeStringCurve(context, teeth, {Rpd::Position(positions[i].zone, ordinal), endPositions[i]}, 0, {false, false}, {false, true}, false, curves[i], &sumOfRadii, &nTeeth);
 		if (distalPoints[i] != Point())
 			curves[i].back() = distalPoints[i];
 		curves[i].push_back(curves[i].back());
 	}
 	auto const& avgRadius = sumOfRadii / nTeeth;
-	for (auto i = 0; i < 2; ++i)
-		for (auto point = curves[i].begin(); point < curves[i].end() - 1; ++point)
-			*point -= roundToPoint(computeNormalDirection(*point) * avgRadius * distanceScales[MESIAL_OR_DISTAL]);
+	vector<Point2f> normalDirections;
+	for (auto i = 0; i < 2; ++i) {
+		computeNormalDirections(context, curves[i], normalDirections);
+		for (auto j = 0; j < curves[i].size() - 1; ++j)
+			curves[i][j] -= roundToPoint(normalDirections[j] * avgRadius * distanceScales[MESIAL_OR_DISTAL]);
+	}
 	Point tmpPoint;
 	if (innerCurve) {
 		if ((*mesialOrdinals)[1] < endPositions[0].ordinal) {
@@ -371,7 +399,7 @@ void computeDistalCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positi
 		if (hasConflict) {
 			auto const& idx = endPositions[0].ordinal == ordinal;
 			auto point = getTooth(teeth, Rpd::Position(endPositions[!idx].zone, endPositions[idx].ordinal)).getCentroid();
-			point -= computeNormalDirection(point) * avgRadius * distanceScales[MESIAL_OR_DISTAL];
+			point -= computeNormalDirection(context, point) * avgRadius * distanceScales[MESIAL_OR_DISTAL];
 			tmpPoint = (*(curves[idx].end() - 3) + roundToPoint(point)) / 2;
 		}
 		else
@@ -381,26 +409,26 @@ void computeDistalCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positi
 			innerCurve->push_back(*(curves[1].end() - 3));
 			innerCurve->push_back((*(curves[1].end() - 3) + (*innerCurve)[0]) / 2);
 		}
-		computeSmoothCurve(*innerCurve, *innerCurve, true);
+		computeSmoothCurve(context, *innerCurve, *innerCurve, true);
 	}
 	curve = vector<Point>{curves[0].rbegin(), curves[0].rbegin() + 2};
 	if (hasConflict) {
 		auto const& idx = endPositions[0].ordinal == ordinal;
 		auto point = getTooth(teeth, Rpd::Position(endPositions[!idx].zone, endPositions[idx].ordinal)).getAnglePoint(180);
-		point -= roundToPoint(computeNormalDirection(point) * avgRadius * distanceScales[MESIAL_OR_DISTAL]);
+		point -= roundToPoint(computeNormalDirection(context, point) * avgRadius * distanceScales[MESIAL_OR_DISTAL]);
 		tmpPoint = (*(curves[idx].end() - 2) + point) / 2;
 	}
 	else
 		tmpPoint = (curves[0][2 - isLevel] + curves[1][2 - isLevel]) / 2;
 	curve.push_back(tmpPoint);
 	curve.insert(curve.end(), curves[1].end() - 2, curves[1].end());
-	computeSmoothCurve(curve, curve);
+	computeSmoothCurve(context, curve, curve);
 }
 
-void computeInnerCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, float const& avgRadius, vector<Point>& curve, vector<vector<Point>>& curves, const vector<Point>* const& anchorPoints) {
+void computeInnerCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, float const& avgRadius, vector<Point>& curve, vector<vector<Point>>& curves, const vector<Point>* const& anchorPoints) {
 	vector<Rpd::Position> startEndPositions;
 	vector<Point> thisAnchorPoints, tmpCurve;
-	findAnchorPoints(teeth, positions, startEndPositions, anchorPoints, &thisAnchorPoints);
+	findAnchorPoints(context, teeth, positions, startEndPositions, anchorPoints, &thisAnchorPoints);
 	if (startEndPositions[0].zone == startEndPositions[1].zone) {
 		auto const& zone = startEndPositions[0].zone;
 		auto const& startOrdinal = startEndPositions[0].ordinal;
@@ -433,16 +461,18 @@ void computeInnerCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 				}
 				auto hasCurve = true;
 				if (lastPosition.zone == thisPosition.zone && lastPosition.ordinal <= thisPosition.ordinal) {
-					computeStringCurve(teeth, {lastPosition, thisPosition}, 0, {false, false}, {false, false}, false, tmpCurve);
+					computeStringCurve(context, teeth, {lastPosition, thisPosition}, 0, {false, false}, {false, false}, false, tmpCurve);
 					if (lastAnchorPoint != Point())
 						tmpCurve[0] = lastAnchorPoint;
 					tmpCurve.insert(tmpCurve.begin(), tmpCurve[0]);
 					if (thisAchorPoint != Point())
 						tmpCurve.back() = thisAchorPoint;
 					tmpCurve.push_back(tmpCurve.back());
+					vector<Point2f> normalDirections;
+					computeNormalDirections(context, tmpCurve, normalDirections);
 					for (auto i = 1; i < tmpCurve.size() - 1; ++i)
-						tmpCurve[i] -= roundToPoint(computeNormalDirection(tmpCurve[i]) * avgRadius * distanceScales[INNER]);
-					computePiecewiseSmoothCurve(tmpCurve, tmpCurve, isStart, isEnd);
+						tmpCurve[i] -= roundToPoint(normalDirections[i] * avgRadius * distanceScales[INNER]);
+					computePiecewiseSmoothCurve(context, tmpCurve, tmpCurve, isStart, isEnd);
 				}
 				else if (lastAnchorPoint != Point() && thisAchorPoint != Point())
 					tmpCurve = {lastAnchorPoint, thisAchorPoint};
@@ -458,8 +488,8 @@ void computeInnerCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 					auto thisStartOrdinal = curOrdinal;
 					while (curOrdinal < endOrdinal) {
 						auto& thisTooth = getTooth(teeth, Rpd::Position(zone, curOrdinal + 1));
-						auto& thisHasLingualConfrontation = thisTooth.hasLingualConfrontation();
-						auto& thisHasSingleDb = thisTooth.hasDentureBase(DentureBase::SINGLE);
+						auto const& thisHasLingualConfrontation = thisTooth.hasLingualConfrontation();
+						auto const& thisHasSingleDb = thisTooth.hasDentureBase(DentureBase::SINGLE);
 						auto const& thisHasClaspRootOrRest = thisTooth.hasClaspRootOrRest(Rpd::MESIAL) || thisTooth.hasClaspRootOrRest(Rpd::DISTAL);
 						if (!hasLingualConfrontation && !hasSingleDb && !thisHasLingualConfrontation && !thisHasSingleDb && !thisHasClaspRootOrRest || hasSingleDb && thisHasSingleDb || hasLingualConfrontation && thisHasLingualConfrontation)
 							++curOrdinal;
@@ -469,12 +499,12 @@ void computeInnerCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 					isEnd = curOrdinal == endOrdinal;
 					tmpCurve.clear();
 					if (hasLingualConfrontation) {
-						computeLingualConfrontationCurve(teeth, {Rpd::Position(zone, thisStartOrdinal), Rpd::Position(zone, curOrdinal)}, tmpCurve);
+						computeLingualConfrontationCurve(context, teeth, {Rpd::Position(zone, thisStartOrdinal), Rpd::Position(zone, curOrdinal)}, tmpCurve);
 						curve.insert(curve.end(), tmpCurve.begin(), tmpCurve.end());
 						curves.push_back(tmpCurve);
 					}
 					else if (hasSingleDb) {
-						computeLingualConfrontationCurve(teeth, {Rpd::Position(zone, thisStartOrdinal), Rpd::Position(zone, curOrdinal)}, tmpCurve);
+						computeLingualConfrontationCurve(context, teeth, {Rpd::Position(zone, thisStartOrdinal), Rpd::Position(zone, curOrdinal)}, tmpCurve);
 						if (isStart && thisAnchorPoints[0] != Point())
 							tmpCurve.insert(tmpCurve.begin(), thisAnchorPoints[0]);
 						if (isEnd && thisAnchorPoints[1] != Point())
@@ -493,8 +523,8 @@ void computeInnerCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 		auto hasLingualConfrontation = true, hasSingleDb = true, hasNone = true;
 		for (auto i = 0; i < 2; ++i) {
 			auto& tooth = getTooth(teeth, Rpd::Position(startEndPositions[i].zone, 0));
-			auto& thisHasLingualConfrontation = tooth.hasLingualConfrontation();
-			auto& thisHasSingleDb = tooth.hasDentureBase(DentureBase::SINGLE);
+			auto const& thisHasLingualConfrontation = tooth.hasLingualConfrontation();
+			auto const& thisHasSingleDb = tooth.hasDentureBase(DentureBase::SINGLE);
 			hasLingualConfrontation &= thisHasLingualConfrontation;
 			hasSingleDb &= thisHasSingleDb;
 			hasNone &= !thisHasLingualConfrontation && !thisHasSingleDb && !tooth.hasClaspRootOrRest(Rpd::MESIAL);
@@ -508,46 +538,48 @@ void computeInnerCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 				auto hasDistalClaspRootOrRest = getTooth(teeth, startPositions[i]).hasClaspRootOrRest(Rpd::DISTAL);
 				while (startPositions[i] < startEndPositions[i]) {
 					auto& thisTooth = getTooth(teeth, ++Rpd::Position(startPositions[i]));
-					auto& thisHasLingualConfrontation = thisTooth.hasLingualConfrontation();
-					auto& thisHasSingleDb = thisTooth.hasDentureBase(DentureBase::SINGLE);
-					auto& thisHasMesialClaspRootOrRest = thisTooth.hasClaspRootOrRest(Rpd::MESIAL);
+					auto const& thisHasLingualConfrontation = thisTooth.hasLingualConfrontation();
+					auto const& thisHasSingleDb = thisTooth.hasDentureBase(DentureBase::SINGLE);
+					auto const& thisHasMesialClaspRootOrRest = thisTooth.hasClaspRootOrRest(Rpd::MESIAL);
 					if (hasNone && !hasDistalClaspRootOrRest && !thisHasLingualConfrontation && !thisHasSingleDb && !thisHasMesialClaspRootOrRest || hasSingleDb && thisHasSingleDb || hasLingualConfrontation && thisHasLingualConfrontation)
 						hasDistalClaspRootOrRest = getTooth(teeth, ++startPositions[i]).hasClaspRootOrRest(Rpd::DISTAL);
 					else
 						break;
 				}
 				auto const& thisStartPosition = ++Rpd::Position(startPositions[i]);
-				computeInnerCurve(teeth, {thisStartPosition, startEndPositions[i]}, avgRadius, thisCurves[i], curves, new vector<Point>{hasNone && !hasDistalClaspRootOrRest ? Point() : getTooth(teeth, startPositions[i]).getAnglePoint(180) , thisAnchorPoints[i]});
+				computeInnerCurve(context, teeth, {thisStartPosition, startEndPositions[i]}, avgRadius, thisCurves[i], curves, new vector<Point>{hasNone && !hasDistalClaspRootOrRest ? Point() : getTooth(teeth, startPositions[i]).getAnglePoint(180) , thisAnchorPoints[i]});
 				if (hasNone && !hasDistalClaspRootOrRest)
 					tmpPoints[i] = getTooth(teeth, thisStartPosition).getAnglePoint(0);
 			}
 			else {
 				auto &tooth = getTooth(teeth, startPositions[i]), &nextTooth = getTooth(teeth, --Rpd::Position(startPositions[i]));
-				computeInnerCurve(teeth, {startPositions[i], startEndPositions[i]}, avgRadius, thisCurves[i], curves, new vector<Point>{(nextTooth.hasLingualConfrontation() || nextTooth.hasDentureBase(DentureBase::SINGLE) || nextTooth.hasClaspRootOrRest(Rpd::MESIAL)) && (i == 0 || !(tooth.hasLingualConfrontation() || tooth.hasDentureBase(DentureBase::SINGLE) || tooth.hasClaspRootOrRest(Rpd::MESIAL))) ? nextTooth.getAnglePoint(0) : Point(), thisAnchorPoints[i]});
+				computeInnerCurve(context, teeth, {startPositions[i], startEndPositions[i]}, avgRadius, thisCurves[i], curves, new vector<Point>{(nextTooth.hasLingualConfrontation() || nextTooth.hasDentureBase(DentureBase::SINGLE) || nextTooth.hasClaspRootOrRest(Rpd::MESIAL)) && (i == 0 || !(tooth.hasLingualConfrontation() || tooth.hasDentureBase(DentureBase::SINGLE) || tooth.hasClaspRootOrRest(Rpd::MESIAL))) ? nextTooth.getAnglePoint(0) : Point(), thisAnchorPoints[i]});
 			}
 		}
 		curve.insert(curve.end(), thisCurves[0].rbegin(), thisCurves[0].rend());
 		if (hasLingualConfrontation) {
-			computeLingualConfrontationCurve(teeth, startPositions, tmpCurve);
+			computeLingualConfrontationCurve(context, teeth, startPositions, tmpCurve);
 			curve.insert(curve.end(), tmpCurve.begin(), tmpCurve.end());
 			curves.push_back(tmpCurve);
 		}
 		else if (hasSingleDb) {
-			computeLingualConfrontationCurve(teeth, startPositions, tmpCurve);
+			computeLingualConfrontationCurve(context, teeth, startPositions, tmpCurve);
 			curve.insert(curve.end(), tmpCurve.begin(), tmpCurve.end());
 		}
 		else if (hasNone) {
-			computeStringCurve(teeth, startPositions, 0, {true, true}, {false, false}, false, tmpCurve);
+			computeStringCurve(context, teeth, startPositions, 0, {true, true}, {false, false}, false, tmpCurve);
 			if (tmpPoints[0] != Point())
 				tmpCurve[0] = tmpPoints[0];
 			if (tmpPoints[1] != Point())
 				tmpCurve.back() = tmpPoints[1];
+			vector<Point2f> normalDirections;
+			computeNormalDirections(context, tmpCurve, normalDirections);
 			for (auto i = 1; i < tmpCurve.size() - 1; ++i)
-				tmpCurve[i] -= roundToPoint(computeNormalDirection(tmpCurve[i]) * avgRadius * distanceScales[INNER]);
+				tmpCurve[i] -= roundToPoint(normalDirections[i] * avgRadius * distanceScales[INNER]);
 			deque<bool> isStartEnds(2);
 			for (auto i = 0; i < 2; ++i)
 				isStartEnds[i] = startPositions[i] == startEndPositions[i];
-			computePiecewiseSmoothCurve(tmpCurve, tmpCurve, isStartEnds[0], isStartEnds[1]);
+			computePiecewiseSmoothCurve(context, tmpCurve, tmpCurve, isStartEnds[0], isStartEnds[1]);
 			curve.insert(curve.end(), tmpCurve.begin(), tmpCurve.end());
 			curves.push_back(tmpCurve);
 		}
@@ -555,13 +587,13 @@ void computeInnerCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 	}
 }
 
-void computeOuterCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve, float* const& avgRadius) {
+void computeOuterCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve, float* const& avgRadius) {
 	vector<Rpd::Position> startEndPositions;
-	findAnchorPoints(teeth, positions, startEndPositions);
+	findAnchorPoints(context, teeth, positions, startEndPositions);
 	vector<Point> dbCurve1, dbCurve2;
 	float sumOfRadii = 0;
 	auto nTeeth = 0;
-	computeStringCurve(teeth, startEndPositions, -distanceScales[OUTER], {true, true}, {true, true}, false, curve, &sumOfRadii, &nTeeth);
+	computeStringCurve(context, teeth, startEndPositions, -distanceScales[OUTER], {true, true}, {true, true}, false, curve, &sumOfRadii, &nTeeth);
 	auto thisAvgRadius = sumOfRadii / nTeeth;
 	if (avgRadius)
 		*avgRadius = thisAvgRadius;
@@ -585,7 +617,7 @@ void computeOuterCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 	if (flag)
 		--++position;
 	if (!isInSameZone || startEndPositions[0].ordinal == 0 || flag)
-		while (!isLastTooth(--Rpd::Position(position))) {
+		while (!isLastTooth(context, --Rpd::Position(position))) {
 			auto& tooth = getTooth(teeth, position);
 			if (tooth.hasDentureBase(DentureBase::DOUBLE)) {
 				sumOfRadii += tooth.getRadius();
@@ -601,9 +633,11 @@ void computeOuterCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 		dbCurve1 = {tooth.getAnglePoint(!isInSameZone || startEndPositions[0].ordinal == 0 ? 0 : 180), tooth.getCentroid()};
 		auto tmpPoint = dbCurve1[0];
 		dbCurve1.insert(dbCurve1.begin(), tmpPoint);
+		vector<Point2f> normalDirections;
+		computeNormalDirections(context, dbCurve1, normalDirections);
 		for (auto i = 1; i < 3; ++i)
-			dbCurve1[i] -= roundToPoint(computeNormalDirection(dbCurve1[i]) * thisAvgRadius * distanceScales[DENTURE_BASE_CURVE]);
-		computeInscribedCurve(dbCurve1, dbCurve1, 1, false);
+			dbCurve1[i] -= roundToPoint(normalDirections[i] * thisAvgRadius * distanceScales[DENTURE_BASE_CURVE]);
+		computeInscribedCurve(context, dbCurve1, dbCurve1, 1, false);
 		dbCurve1.insert(dbCurve1.begin(), tmpPoint);
 		if (avgRadius)
 			dbCurve1.insert(dbCurve1.begin(), curve[0]);
@@ -613,7 +647,7 @@ void computeOuterCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 	dbPosition = ++Rpd::Position(startEndPositions[1]);
 	sumOfRadii = nTeeth = 0;
 	position = dbPosition;
-	while (!isLastTooth(--Rpd::Position(position))) {
+	while (!isLastTooth(context, --Rpd::Position(position))) {
 		auto& tooth = getTooth(teeth, position);
 		if (tooth.hasDentureBase(DentureBase::DOUBLE)) {
 			sumOfRadii += tooth.getRadius();
@@ -629,39 +663,41 @@ void computeOuterCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Positio
 		dbCurve2 = {tooth.getCentroid(), tooth.getAnglePoint(0)};
 		auto tmpPoint = dbCurve2.back();
 		dbCurve2.push_back(tmpPoint);
+		vector<Point2f> normalDirections;
+		computeNormalDirections(context, dbCurve2, normalDirections);
 		for (auto i = 0; i < 2; ++i)
-			dbCurve2[i] -= roundToPoint(computeNormalDirection(dbCurve2[i]) * thisAvgRadius * distanceScales[DENTURE_BASE_CURVE]);
-		computeInscribedCurve(dbCurve2, dbCurve2, 1, false);
+			dbCurve2[i] -= roundToPoint(normalDirections[i] * thisAvgRadius * distanceScales[DENTURE_BASE_CURVE]);
+		computeInscribedCurve(context, dbCurve2, dbCurve2, 1, false);
 		dbCurve2.push_back(tmpPoint);
 		if (avgRadius)
 			dbCurve2.push_back(curve.back());
 		curve.back() = dbCurve2[0];
 		curve.erase(curve.end() - 2);
 	}
-	computeSmoothCurve(curve, curve);
+	computeSmoothCurve(context, curve, curve);
 	curve.insert(curve.begin(), dbCurve1.begin(), dbCurve1.end());
 	curve.insert(curve.end(), dbCurve2.begin(), dbCurve2.end());
 }
 
-void computeLingualConfrontationCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve) {
+void computeLingualConfrontationCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve) {
 	if (positions[0].zone == positions[1].zone)
 		for (auto position = positions[0]; position <= positions[1]; ++position) {
-			auto thisCurve = getTooth(teeth, position).getCurve(180, 0);
+			auto const& thisCurve = getTooth(teeth, position).getCurve(180, 0);
 			curve.insert(curve.end(), thisCurve.rbegin(), thisCurve.rend());
 		}
 	else {
 		vector<vector<Point>> tmpCurves(2);
 		for (auto i = 0; i < 2; ++i)
-			computeLingualConfrontationCurve(teeth, {Rpd::Position(positions[i].zone, 0), positions[i]}, tmpCurves[i]);
+			computeLingualConfrontationCurve(context, teeth, {Rpd::Position(positions[i].zone, 0), positions[i]}, tmpCurves[i]);
 		curve = tmpCurves[1];
 		curve.insert(curve.begin(), tmpCurves[0].rbegin(), tmpCurves[0].rend());
 	}
 }
 
-void computeLingualConfrontationCurves(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<vector<Point>>& curves) {
+void computeLingualConfrontationCurves(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<vector<Point>>& curves) {
 	if (positions.size() == 4) {
-		computeLingualConfrontationCurves(teeth, {positions[0], positions[1]}, curves);
-		computeLingualConfrontationCurves(teeth, {positions[2], positions[3]}, curves);
+		computeLingualConfrontationCurves(context, teeth, {positions[0], positions[1]}, curves);
+		computeLingualConfrontationCurves(context, teeth, {positions[2], positions[3]}, curves);
 	}
 	else if (positions[0].zone == positions[1].zone) {
 		auto const& zone = positions[0].zone;
@@ -676,7 +712,7 @@ void computeLingualConfrontationCurves(const vector<Tooth> (&teeth)[nZones], vec
 			while (curOrdinal < endOrdinal && getTooth(teeth, Rpd::Position(zone, curOrdinal + 1)).hasLingualConfrontation())
 				++curOrdinal;
 			vector<Point> tmpCurve;
-			computeLingualConfrontationCurve(teeth, {Rpd::Position(zone, startOrdinal) , Rpd::Position(zone, curOrdinal)}, tmpCurve);
+			computeLingualConfrontationCurve(context, teeth, {Rpd::Position(zone, startOrdinal) , Rpd::Position(zone, curOrdinal)}, tmpCurve);
 			curves.push_back(tmpCurve);
 		}
 	}
@@ -686,186 +722,384 @@ void computeLingualConfrontationCurves(const vector<Tooth> (&teeth)[nZones], vec
 			lcPositions[i].ordinal = -1;
 			while (lcPositions[i] < positions[i] && getTooth(teeth, ++Rpd::Position(lcPositions[i])).hasLingualConfrontation())
 				++lcPositions[i];
-			computeLingualConfrontationCurves(teeth, {++lcPositions[i], positions[i]}, curves);
+			computeLingualConfrontationCurves(context, teeth, {++lcPositions[i], positions[i]}, curves);
 			--lcPositions[i];
 		}
 		if (lcPositions[0] < lcPositions[1]) {
 			vector<Point> tmpCurve;
-			computeLingualConfrontationCurve(teeth, lcPositions, tmpCurve);
+			computeLingualConfrontationCurve(context, teeth, lcPositions, tmpCurve);
 			curves.push_back(tmpCurve);
 		}
 	}
 }
 
-Point2f computeNormalDirection(Point2f const& point, float* const& angle) {
-	auto const& curTeethEllipse = remedyImage ? remediedTeethEllipse : teethEllipse;
+Point2f computeCentroid(vector<Point> const& contour, float* const& radius) {
+	auto const& moment = moments(contour);
+	if (radius)
+		*radius = sqrt(moment.m00 / CV_PI);
+	return Point2f(moment.m10 / moment.m00, moment.m01 / moment.m00);
+}
+
+Point2f computeNormalDirection(DesignContext const& context, Point2f const& point, float* const& angle) {
+	auto const& curTeethEllipse = context.getTeethEllipse();
 	auto const& direction = point - curTeethEllipse.center;
-	auto thisAngle = atan2(direction.y, direction.x) - degreeToRadian(curTeethEllipse.angle);
-	if (thisAngle < -CV_PI)
-		thisAngle += CV_2PI;
-	if (angle)
-		*angle = thisAngle;
-	return normalize(Point2f(pow(curTeethEllipse.size.height, 2) * cos(thisAngle), pow(curTeethEllipse.size.width, 2) * sin(thisAngle)));
+	auto const& ellipseAngle = degreeToRadian(curTeethEllipse.angle);
+	if (angle) {
+		*angle = atan2(direction.y, direction.x) - ellipseAngle;
+		if (*angle < -CV_PI)
+			*angle += CV_2PI;
+	}
+	auto const& cosine = cos(ellipseAngle), sine = sin(ellipseAngle);
+	auto const& normalDirection = Point2f(curTeethEllipse.size.height * curTeethEllipse.size.height * (direction.x * cosine + direction.y * sine), curTeethEllipse.size.width * curTeethEllipse.size.width * (direction.y * cosine - direction.x * sine));
+	return normalDirection / sqrt(normalDirection.dot(normalDirection));
+}
+
+void computeNormalDirections(DesignContext const& context, vector<Point> const& points, vector<Point2f>& normalDirections) {
+	auto const& curTeethEllipse = context.getTeethEllipse();
+	auto const& ellipseAngle = degreeToRadian(curTeethEllipse.angle);
+	auto const& cosine = cos(ellipseAngle), sine = sin(ellipseAngle);
+	auto const& scaleX = curTeethEllipse.size.height * curTeethEllipse.size.height, scaleY = curTeethEllipse.size.width * curTeethEllipse.size.width;
+	auto const& centerX = curTeethEllipse.center.x, centerY = curTeethEllipse.center.y;
+	auto const& nPoints = static_cast<int>(points.size());
+	normalDirections.resize(nPoints);
+	auto const& thisPoints = points.data();
+	auto const& thisNormalDirections = normalDirections.data();
+	for (auto i = 0; i < nPoints; ++i) {
+		auto const& x = thisPoints[i].x - centerX, y = thisPoints[i].y - centerY;
+		auto const& normalX = scaleX * (x * cosine + y * sine), normalY = scaleY * (y * cosine - x * sine);
+		auto const& length = sqrt(normalX * normalX + normalY * normalY);
+		thisNormalDirections[i] = Point2f(normalX / length, normalY / length);
+	}
+}
+
+void computeOffsetCurves(DesignContext const& context, vector<Point> const& curve, float const& distance, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, vector<vector<Point>>& curves) {
+	auto const& curTeethEllipse = context.getTeethEllipse();
+	auto const& ellipseAngle = degreeToRadian(curTeethEllipse.angle);
+	auto const& cosine = cos(ellipseAngle), sine = sin(ellipseAngle);
+	auto const& scaleX = curTeethEllipse.size.height * curTeethEllipse.size.height, scaleY = curTeethEllipse.size.width * curTeethEllipse.size.width;
+	auto const& centerX = curTeethEllipse.center.x, centerY = curTeethEllipse.center.y;
+	auto const& nPoints = static_cast<int>(curve.size());
+	auto const& nStartPoints = keepStartEndPoints[0] ? 1 : 0, nEndPoints = keepStartEndPoints[1] ? 1 : 0;
+	vector<float> buffer(nPoints * 4);
+	auto const& xs = buffer.data(), ys = xs + nPoints, deltaXs = ys + nPoints, deltaYs = deltaXs + nPoints;
+	auto const& thisCurve = curve.data();
+	for (auto i = 0; i < nPoints; ++i) {
+		xs[i] = thisCurve[i].x;
+		ys[i] = thisCurve[i].y;
+	}
+	for (auto i = 0; i < nPoints; ++i) {
+		auto const& x = xs[i] - centerX, y = ys[i] - centerY;
+		auto const& normalX = scaleX * (x * cosine + y * sine), normalY = scaleY * (y * cosine - x * sine);
+		auto const& length = sqrt(normalX * normalX + normalY * normalY);
+		deltaXs[i] = normalX / length * distance;
+		deltaYs[i] = normalY / length * distance;
+	}
+	curves.resize(distanceScales.size());
+	for (auto j = 0; j < distanceScales.size(); ++j) {
+		auto& offsetCurve = curves[j];
+		offsetCurve.resize(nStartPoints + nPoints + nEndPoints);
+		auto const& offsetPoints = offsetCurve.data() + nStartPoints;
+		auto const& distanceScale = distanceScales[j];
+		for (auto i = 0; i < nPoints; ++i)
+			offsetPoints[i] = Point(thisCurve[i].x + static_cast<int>(round(deltaXs[i] * distanceScale)), thisCurve[i].y + static_cast<int>(round(deltaYs[i] * distanceScale)));
+		if (nStartPoints)
+			offsetCurve.front() = curve.front();
+		if (nEndPoints)
+			offsetCurve.back() = curve.back();
+	}
 }
 
-bool shouldAnchor(const vector<Tooth> (&teeth)[nZones], Rpd::Position const& position, Rpd::Direction const& direction) {
+bool shouldAnchor(DesignContext const& context, TeethModel const& teeth, Rpd::Position const& position, Rpd::Direction const& direction) {
 	auto& tooth = getTooth(teeth, position);
 	if (tooth.hasClaspRootOrRest(direction) || tooth.expectDentureBaseAnchor(direction) || tooth.hasLingualConfrontation())
 		return true;
 	if (direction == Rpd::MESIAL)
 		return getTooth(teeth, --Rpd::Position(position)).expectDentureBaseAnchor(position.ordinal ? Rpd::DISTAL : Rpd::MESIAL);
-	return !isLastTooth(position) && getTooth(teeth, ++Rpd::Position(position)).expectDentureBaseAnchor(Rpd::MESIAL);
+	return !isLastTooth(context, position) && getTooth(teeth, ++Rpd::Position(position)).expectDentureBaseAnchor(Rpd::MESIAL);
+}
+
+bool isLastTooth(DesignContext const& context, Rpd::Position const& position) { return position.ordinal == nTeethPerZone + context.isEighthUsed[position.zone] - 2; }
+
+int queryInt(JNIEnv* const& env, JniRegistry const& registry, jobject const& property, jobject const& individual) {
+	auto const& tmp = env->CallObjectMethod(individual, registry.midResourceGetProperty, property);
+	if (!tmp)
+		return -1;
+	auto const& value = env->CallIntMethod(tmp, registry.midGetInt);
+	env->DeleteLocalRef(tmp);
+	return value;
 }
 
-bool isLastTooth(Rpd::Position const& position) { return position.ordinal == nTeethPerZone + Tooth::isEighthUsed[position.zone] - 2; }
+int queryBoolean(JNIEnv* const& env, JniRegistry const& registry, jobject const& property, jobject const& individual) {
+	auto const& tmp = env->CallObjectMethod(individual, registry.midResourceGetProperty, property);
+	if (!tmp)
+		return -1;
+	auto const& value = env->CallBooleanMethod(tmp, registry.midGetBoolean);
+	env->DeleteLocalRef(tmp);
+	return value;
+}
 
-bool queryRpds(JNIEnv* const& env, jobject const& ontModel, vector<Rpd*>& rpds) {
-	auto const& clsStrExtendedIterator = "org/apache/jena/util/iterator/ExtendedIterator";
-	auto const& clsStrIndividual = "org/apache/jena/ontology/Individual";
-	auto const& clsStrIterator = "java/util/Iterator";
-	auto const& clsStrModelCon = "org/apache/jena/rdf/model/ModelCon";
-	auto const& clsStrObject = "java/lang/Object";
-	auto const& clsStrOntClass = "org/apache/jena/ontology/OntClass";
-	auto const& clsStrOntModel = "org/apache/jena/ontology/OntModel";
-	auto const& clsStrProperty = "org/apache/jena/rdf/model/Property";
-	auto const& clsStrResource = "org/apache/jena/rdf/model/Resource";
-	auto const& clsStrStatement = "org/apache/jena/rdf/model/Statement";
-	auto const& clsStrStmtIterator = "org/apache/jena/rdf/model/StmtIterator";
-	auto const& clsStrString = "java/lang/String";
-	auto const& clsIndividual = env->FindClass(clsStrIndividual);
-	auto const& clsIterator = env->FindClass(clsStrIterator);
-	auto const& clsModelCon = env->FindClass(clsStrModelCon);
-	auto const& clsOntModel = env->FindClass(clsStrOntModel);
-	auto const& clsResource = env->FindClass(clsStrResource);
-	auto const& clsStatement = env->FindClass(clsStrStatement);
-	auto const& midGetBoolean = env->GetMethodID(clsStatement, "getBoolean", "()Z");
-	auto const& midGetInt = env->GetMethodID(clsStatement, "getInt", "()I");
-	auto const& midGetLocalName = env->GetMethodID(clsResource, "getLocalName", ("()" + getClsSig(clsStrString)).c_str());
-	auto const& midGetOntClass = env->GetMethodID(clsIndividual, "getOntClass", ("()" + getClsSig(clsStrOntClass)).c_str());
-	auto const& midHasNext = env->GetMethodID(clsIterator, "hasNext", "()Z");
-	auto const& midListIndividuals = env->GetMethodID(clsOntModel, "listIndividuals", ("()" + getClsSig(clsStrExtendedIterator)).c_str());
-	auto const& midListProperties = env->GetMethodID(clsResource, "listProperties", ('(' + getClsSig(clsStrProperty) + ')' + getClsSig(clsStrStmtIterator)).c_str());
-	auto const& midModelConGetProperty = env->GetMethodID(clsModelCon, "getProperty", ('(' + getClsSig(clsStrString) + ')' + getClsSig(clsStrProperty)).c_str());
-	auto const& midNext = env->GetMethodID(clsIterator, "next", ("()" + getClsSig(clsStrObject)).c_str());
-	auto const& midResourceGetProperty = env->GetMethodID(clsResource, "getProperty", ('(' + getClsSig(clsStrProperty) + ')' + getClsSig(clsStrStatement)).c_str());
-	auto const& midStatementGetProperty = env->GetMethodID(clsStatement, "getProperty", ('(' + getClsSig(clsStrProperty) + ')' + getClsSig(clsStrStatement)).c_str());
-	string const& ontPrefix = "http://www.semanticweb.org/msiip/ontologies/CDSSinRPD#";
-	auto tmpStr = env->NewStringUTF((ontPrefix + "clasp_material").c_str());
-	auto const& dpClaspMaterial = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "clasp_tip_direction").c_str());
-	auto const& dpClaspTipDirection = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "clasp_tip_side").c_str());
-	auto const& dpClaspTipSide = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "component_position").c_str());
-	auto opComponentPosition = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "enable_buccal_arm").c_str());
-	auto const& dpEnableBuccalArm = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "enable_lingual_arm").c_str());
-	auto const& dpEnableLingualArm = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "enable_rest").c_str());
-	auto const& dpEnableRest = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "is_missing").c_str());
-	auto const& dpIsMissing = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "lingual_confrontation").c_str());
-	auto const& dpLingualConfrontation = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "rest_mesial_or_distal").c_str());
-	auto const& dpRestMesialOrDistal = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "tooth_ordinal").c_str());
-	auto const& dpToothOrdinal = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	tmpStr = env->NewStringUTF((ontPrefix + "tooth_zone").c_str());
-	auto const& dpToothZone = env->CallObjectMethod(ontModel, midModelConGetProperty, tmpStr);
-	env->DeleteLocalRef(tmpStr);
-	auto const& individuals = env->CallObjectMethod(ontModel, midListIndividuals);
-	auto const& isValid = env->CallBooleanMethod(individuals, midHasNext);
-	vector<Rpd*> thisRpds;
+bool queryPositions(JNIEnv* const& env, JniRegistry const& registry, jobject const& property, jobject const& individual, vector<Rpd::Position>& positions) {
+	auto const& teeth = env->CallObjectMethod(individual, registry.midListProperties, property);
+	while (env->CallBooleanMethod(teeth, registry.midHasNext)) {
+		if (env->PushLocalFrame(3) != JNI_OK) {
+			env->DeleteLocalRef(teeth);
+			return false;
+		}
+		auto const& tooth = env->CallObjectMethod(teeth, registry.midNext);
+		auto const& zone = env->CallIntMethod(env->CallObjectMethod(tooth, registry.midStatementGetProperty, registry.dpToothZone), registry.midGetInt) - 1;
+		auto const& ordinal = env->CallIntMethod(env->CallObjectMethod(tooth, registry.midStatementGetProperty, registry.dpToothOrdinal), registry.midGetInt) - 1;
+		positions.push_back(Rpd::Position(zone, ordinal));
+		env->PopLocalFrame(nullptr);
+	}
+	env->DeleteLocalRef(teeth);
+	return true;
+}
+
+bool createRpds(vector<Individual> const& individuals, RpdStore& rpds, bool (&isEighthToothUsed)[nZones]) {
+	RpdStore thisRpds;
 	bool thisIsEighthToothUsed[nZones] = {};
-	while (env->CallBooleanMethod(individuals, midHasNext)) {
-		auto const& individual = env->CallObjectMethod(individuals, midNext);
-		auto const& ontClassStr = env->GetStringUTFChars(static_cast<jstring>(env->CallObjectMethod(env->CallObjectMethod(individual, midGetOntClass), midGetLocalName)), nullptr);
-		auto const& tmpIt = rpdMapping_.find(ontClassStr);
-		switch (tmpIt == rpdMapping_.end() ? -1 : tmpIt->second) {
+	for (auto individual = individuals.begin(); individual < individuals.end(); ++individual) {
+		auto const& nRpds = thisRpds.size();
+		switch (individual->rpdClass) {
 			case AKERS_CLASP:
-				thisRpds.push_back(AkersClasp::createFromIndividual(env, midGetBoolean, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpClaspTipDirection, dpClaspMaterial, dpEnableBuccalArm, dpEnableLingualArm, dpEnableRest, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(AkersClasp::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case CANINE_AKERS_CLASP:
-				thisRpds.push_back(CanineAkersClasp::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpClaspTipDirection, dpClaspMaterial, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(CanineAkersClasp::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case COMBINATION_ANTERIOR_POSTERIOR_PALATAL_STRAP:
-				thisRpds.push_back(CombinationAnteriorPosteriorPalatalStrap::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(CombinationAnteriorPosteriorPalatalStrap::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case COMBINATION_CLASP:
-				thisRpds.push_back(CombinationClasp::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpClaspTipDirection, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(CombinationClasp::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case COMBINED_CLASP:
-				thisRpds.push_back(CombinedClasp::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpClaspMaterial, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(CombinedClasp::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case CONTINUOUS_CLASP:
-				thisRpds.push_back(ContinuousClasp::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpClaspMaterial, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(ContinuousClasp::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case DENTURE_BASE:
-				thisRpds.push_back(DentureBase::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(DentureBase::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case EDENTULOUS_SPACE:
-				thisRpds.push_back(EdentulousSpace::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(EdentulousSpace::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case FULL_PALATAL_PLATE:
-				thisRpds.push_back(FullPalatalPlate::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(FullPalatalPlate::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case LINGUAL_BAR:
-				thisRpds.push_back(LingualBar::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(LingualBar::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case LINGUAL_PLATE:
-				thisRpds.push_back(LingualPlate::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(LingualPlate::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case LINGUAL_REST:
-				thisRpds.push_back(LingualRest::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpRestMesialOrDistal, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(LingualRest::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case OCCLUSAL_REST:
-				thisRpds.push_back(OcclusalRest::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpRestMesialOrDistal, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(OcclusalRest::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case PALATAL_PLATE:
-				thisRpds.push_back(PalatalPlate::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpLingualConfrontation, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(PalatalPlate::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case RING_CLASP:
-				thisRpds.push_back(RingClasp::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpClaspMaterial, dpClaspTipSide, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(RingClasp::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case RPA:
-				thisRpds.push_back(Rpa::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpClaspMaterial, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(Rpa::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			case RPI:
-				thisRpds.push_back(Rpi::createFromIndividual(env, midGetInt, midHasNext, midListProperties, midNext, midStatementGetProperty, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(Rpi::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
-			case TOOTH: {
-				auto const& tmp = env->CallObjectMethod(individual, midResourceGetProperty, dpIsMissing);
-				if (!(tmp && env->CallBooleanMethod(tmp, midGetBoolean)) && env->CallIntMethod(env->CallObjectMethod(individual, midResourceGetProperty, dpToothOrdinal), midGetInt) == nTeethPerZone)
-					thisIsEighthToothUsed[env->CallIntMethod(env->CallObjectMethod(individual, midResourceGetProperty, dpToothZone), midGetInt) - 1] = true;
-			}
+			case TOOTH:
+				if (individual->isMissing != 1 && individual->positions.size() && individual->positions[0].ordinal == nTeethPerZone - 1)
+					thisIsEighthToothUsed[individual->positions[0].zone] = true;
 				break;
 			case WW_CLASP:
-				thisRpds.push_back(WwClasp::createFromIndividual(env, midGetBoolean, midGetInt, midHasNext, midListProperties, midNext, midResourceGetProperty, midStatementGetProperty, dpClaspTipDirection, dpEnableBuccalArm, dpEnableLingualArm, dpEnableRest, dpToothZone, dpToothOrdinal, opComponentPosition, individual, thisIsEighthToothUsed));
+				thisRpds.add(WwClasp::createFromIndividual(*individual, thisIsEighthToothUsed));
 				break;
 			default: ;
 		}
+		if (thisRpds.size() > nRpds)
+			thisRpds.getRpds().back()->setIndividual(*individual);
 	}
+	auto const& isValid = !individuals.empty();
 	if (isValid) {
-		rpds = thisRpds;
-		copy(begin(thisIsEighthToothUsed), end(thisIsEighthToothUsed), Tooth::isEighthUsed);
+		rpds = move(thisRpds);
+		copy(begin(thisIsEighthToothUsed), end(thisIsEighthToothUsed), isEighthToothUsed);
 	}
 	return isValid;
 }
 
-void analyzeBaseImage(Mat const& base, vector<Tooth> (&remediedTeeth)[nZones], Mat (&remediedDesignImages)[2], vector<Tooth> (*const& teeth)[nZones], Mat (*const& designImages)[2], Mat* const& baseImage) {
+bool queryIndividual(JNIEnv* const& env, JniRegistry const& registry, jobject const& jIndividual, Individual& individual) {
+	switch (individual.rpdClass) {
+		case TOOTH:
+			individual.isMissing = queryBoolean(env, registry, registry.dpIsMissing, jIndividual);
+			individual.positions.push_back(Rpd::Position(queryInt(env, registry, registry.dpToothZone, jIndividual) - 1, queryInt(env, registry, registry.dpToothOrdinal, jIndividual) - 1));
+			return true;
+		case COMBINATION_ANTERIOR_POSTERIOR_PALATAL_STRAP:
+		case FULL_PALATAL_PLATE:
+		case LINGUAL_BAR:
+		case LINGUAL_PLATE:
+		case PALATAL_PLATE:
+			if (!queryPositions(env, registry, registry.dpLingualConfrontation, jIndividual, individual.lingualConfrontations))
+				return false;
+			break;
+		case AKERS_CLASP:
+		case WW_CLASP:
+			individual.enableBuccalArm = queryBoolean(env, registry, registry.dpEnableBuccalArm, jIndividual);
+			individual.enableLingualArm = queryBoolean(env, registry, registry.dpEnableLingualArm, jIndividual);
+			individual.enableRest = queryBoolean(env, registry, registry.dpEnableRest, jIndividual);
+			break;
+		case LINGUAL_REST:
+		case OCCLUSAL_REST:
+			individual.restMesialOrDistal = queryInt(env, registry, registry.dpRestMesialOrDistal, jIndividual);
+			break;
+		case RING_CLASP:
+			individual.claspTipSide = queryInt(env, registry, registry.dpClaspTipSide, jIndividual);
+			break;
+		default: ;
+	}
+	switch (individual.rpdClass) {
+		case AKERS_CLASP:
+		case CANINE_AKERS_CLASP:
+		case COMBINATION_CLASP:
+		case WW_CLASP:
+			individual.claspTipDirection = queryInt(env, registry, registry.dpClaspTipDirection, jIndividual);
+			break;
+		default: ;
+	}
+	switch (individual.rpdClass) {
+		case AKERS_CLASP:
+		case CANINE_AKERS_CLASP:
+		case COMBINED_CLASP:
+		case CONTINUOUS_CLASP:
+		case RING_CLASP:
+		case RPA:
+			individual.claspMaterial = queryInt(env, registry, registry.dpClaspMaterial, jIndividual);
+			break;
+		default: ;
+	}
+	return queryPositions(env, registry, registry.opComponentPosition, jIndividual, individual.positions);
+}
+
+bool queryIndividuals(JNIEnv* const& env, JniRegistry const& registry, jobject const& ontModel, vector<Individual>& individuals) {
+	auto const& jIndividuals = env->CallObjectMethod(ontModel, registry.midListIndividuals);
+	while (env->CallBooleanMethod(jIndividuals, registry.midHasNext)) {
+		if (env->PushLocalFrame(16) != JNI_OK) {
+			env->DeleteLocalRef(jIndividuals);
+			return false;
+		}
+		auto const& jIndividual = env->CallObjectMethod(jIndividuals, registry.midNext);
+		auto const& ontClass = env->CallObjectMethod(jIndividual, registry.midGetOntClass);
+		if (ontClass) {
+			auto const& localName = static_cast<jstring>(env->CallObjectMethod(ontClass, registry.midGetLocalName));
+			auto const& ontClassStr = env->GetStringUTFChars(localName, nullptr);
+			auto const& tmpIt = rpdMapping_.find(ontClassStr);
+			env->ReleaseStringUTFChars(localName, ontClassStr);
+			if (tmpIt != rpdMapping_.end()) {
+				individuals.push_back(Individual(tmpIt->second));
+				if (!queryIndividual(env, registry, jIndividual, individuals.back())) {
+					env->PopLocalFrame(nullptr);
+					env->DeleteLocalRef(jIndividuals);
+					return false;
+				}
+			}
+		}
+		env->PopLocalFrame(nullptr);
+	}
+	env->DeleteLocalRef(jIndividuals);
+	return true;
+}
+
+bool isValidFlattening(vector<jint> const (&columns)[N_FLATTENED_COLUMNS], size_t const& nClasses) {
+	auto const& nIndividuals = columns[CLASS_ID].size();
+	for (int i = CLASS_ID + 1; i < POSITIONS; ++i)
+		if (columns[i].size() != nIndividuals)
+			return false;
+	size_t nPositions = 0, nLingualConfrontations = 0;
+	for (auto i = 0U; i < nIndividuals; ++i) {
+		if (columns[CLASS_ID][i] < 0 || static_cast<size_t>(columns[CLASS_ID][i]) >= nClasses || columns[N_POSITIONS][i] < 0 || columns[N_LINGUAL_CONFRONTATIONS][i] < 0)
+			return false;
+		nPositions += columns[N_POSITIONS][i];
+		nLingualConfrontations += columns[N_LINGUAL_CONFRONTATIONS][i];
+	}
+	if (columns[POSITIONS].size() != nPositions * 2 || columns[LINGUAL_CONFRONTATIONS].size() != nLingualConfrontations * 2)
+		return false;
+	for (int i = POSITIONS; i <= LINGUAL_CONFRONTATIONS; ++i)
+		for (auto position = columns[i].begin(); position < columns[i].end(); position += 2)
+			if (position[0] < 0 || position[0] >= nZones || position[1] < 0 || position[1] >= nTeethPerZone)
+				return false;
+	return true;
+}
+
+bool queryIndividualsInBulk(JNIEnv* const& env, JniRegistry const& registry, jobject const& ontModel, vector<Individual>& individuals) {
+	auto const& flattened = static_cast<jobjectArray>(env->CallStaticObjectMethod(registry.clsIndividualFlattener, registry.midFlatten, ontModel, registry.classNames));
+	if (!flattened || env->ExceptionCheck()) {
+		env->ExceptionClear();
+		return false;
+	}
+	if (env->GetArrayLength(flattened) != N_FLATTENED_COLUMNS) {
+		env->DeleteLocalRef(flattened);
+		return false;
+	}
+	vector<jint> columns[N_FLATTENED_COLUMNS];
+	for (auto i = 0; i < N_FLATTENED_COLUMNS; ++i) {
+		auto const& column = static_cast<jintArray>(env->GetObjectArrayElement(flattened, i));
+		if (!column) {
+			env->DeleteLocalRef(flattened);
+			return false;
+		}
+		columns[i].resize(env->GetArrayLength(column));
+		if (!columns[i].empty())
+			env->GetIntArrayRegion(column, 0, static_cast<jsize>(columns[i].size()), columns[i].data());
+		env->DeleteLocalRef(column);
+	}
+	env->DeleteLocalRef(flattened);
+	vector<RpdClass> rpdClasses;
+	for (auto it = rpdMapping_.begin(); it != rpdMapping_.end(); ++it)
+		rpdClasses.push_back(it->second);
+	if (!isValidFlattening(columns, rpdClasses.size()))
+		return false;
+	auto const& nIndividuals = columns[CLASS_ID].size();
+	individuals.reserve(individuals.size() + nIndividuals);
+	auto position = columns[POSITIONS].begin(), lingualConfrontation = columns[LINGUAL_CONFRONTATIONS].begin();
+	for (auto i = 0U; i < nIndividuals; ++i) {
+		individuals.push_back(Individual(rpdClasses[columns[CLASS_ID][i]]));
+		auto& individual = individuals.back();
+		individual.claspMaterial = columns[CLASP_MATERIAL][i];
+		individual.claspTipDirection = columns[CLASP_TIP_DIRECTION][i];
+		individual.claspTipSide = columns[CLASP_TIP_SIDE][i];
+		individual.enableBuccalArm = columns[ENABLE_BUCCAL_ARM][i];
+		individual.enableLingualArm = columns[ENABLE_LINGUAL_ARM][i];
+		individual.enableRest = columns[ENABLE_REST][i];
+		individual.isMissing = columns[IS_MISSING][i];
+		individual.restMesialOrDistal = columns[REST_MESIAL_OR_DISTAL][i];
+		for (auto j = 0; j < columns[N_POSITIONS][i]; ++j, position += 2)
+			individual.positions.push_back(Rpd::Position(position[0], position[1]));
+		for (auto j = 0; j < columns[N_LINGUAL_CONFRONTATIONS][i]; ++j, lingualConfrontation += 2)
+			individual.lingualConfrontations.push_back(Rpd::Position(lingualConfrontation[0], lingualConfrontation[1]));
+	}
+	return true;
+}
+
+bool queryRpds(JNIEnv* const& env, jobject const& ontModel, RpdStore& rpds, bool (&isEighthToothUsed)[nZones]) {
+	auto const& registry = JniRegistry::getOntology();
+	if (!registry)
+		return false;
+	vector<Individual> individuals;
+	if ((!registry->clsIndividualFlattener || !queryIndividualsInBulk(env, *registry, ontModel, individuals)) && !queryIndividuals(env, *registry, ontModel, individuals))
+		return false;
+	return createRpds(individuals, rpds, isEighthToothUsed);
+}
+
+bool queryRpds(string const& fileName, RpdStore& rpds, bool (&isEighthToothUsed)[nZones]) {
+	vector<Individual> individuals;
+	return (DesignSpec::read(fileName, individuals) || OwlReader::read(fileName, individuals)) && createRpds(individuals, rpds, isEighthToothUsed);
+}
+
+void analyzeBaseImage(Mat const& base, DesignContext& context, TeethModel& remediedTeeth, Mat (&remediedDesignImages)[2], TeethModel* const& teeth, Mat (*const& designImages)[2], Mat* const& baseImage) {
 	Mat thisBaseImage;
 	copyMakeBorder(base, thisBaseImage, 80, 80, 80, 80, BORDER_CONSTANT, Scalar::all(255));
 	if (baseImage)
@@ -874,163 +1108,205 @@ void analyzeBaseImage(Mat const& base, vector<Tooth> (&remediedTeeth)[nZones], M
 	cvtColor(thisBaseImage, tmpImage, COLOR_BGR2GRAY);
 	threshold(tmpImage, tmpImage, 0, 255, THRESH_BINARY | THRESH_OTSU);
 	vector<vector<Point>> contours;
-	vector<Tooth> tmpTeeth;
+	vector<int> toothContourIndices;
 	vector<Vec4i> hierarchy;
 	findContours(tmpImage, contours, hierarchy, RETR_TREE, CHAIN_APPROX_SIMPLE);
-	for (auto i = hierarchy[0][2]; i >= 0; i = hierarchy[i][0])
-		for (auto j = hierarchy[i][2]; j >= 0; j = hierarchy[j][0])
-			tmpTeeth.push_back(Tooth(contours[j]));
 	vector<Point2f> centroids;
-	for (auto tooth = tmpTeeth.begin(); tooth < tmpTeeth.end(); ++tooth)
-		centroids.push_back(tooth->getCentroid());
-	teethEllipse = fitEllipse(centroids);
+	for (auto i = hierarchy[0][2]; i >= 0; i = hierarchy[i][0])
+		for (auto j = hierarchy[i][2]; j >= 0; j = hierarchy[j][0]) {
+			toothContourIndices.push_back(j);
+			centroids.push_back(computeCentroid(contours[j]));
+		}
+	context.teethEllipse = fitEllipse(centroids);
 	auto const& nTeeth = (nTeethPerZone - 1) * nZones;
 	vector<float> angles(nTeeth);
-	auto oldRemedyImage = remedyImage;
-	remedyImage = false;
+	context.isRemedied = false;
 	for (auto i = 0; i < nTeeth; ++i)
-		computeNormalDirection(centroids[i], &angles[i]);
+		computeNormalDirection(context, centroids[i], &angles[i]);
 	vector<int> idx;
 	sortIdx(angles, idx, SORT_ASCENDING);
 	vector<vector<uint8_t>> isInZone(nZones);
-	vector<Tooth> thisTeeth[nZones];
-	for (auto i = 0; i < nZones; ++i) {
+	vector<int> thisToothContourIndices[nZones];
+	for (auto i = 0; i < nZones; ++i)
 		inRange(angles, CV_2PI / nZones * (i - 2), CV_2PI / nZones * (i - 1), isInZone[i]);
-		thisTeeth[i].clear();
-	}
 	for (auto i = 0; i < nTeeth; ++i) {
 		auto const& no = idx[i];
 		for (auto j = 0; j < nZones; ++j)
 			if (isInZone[j][no]) {
 				if (j % 2)
-					thisTeeth[j].push_back(tmpTeeth[no]);
+					thisToothContourIndices[j].push_back(toothContourIndices[no]);
 				else
-					thisTeeth[j].insert(thisTeeth[j].begin(), tmpTeeth[no]);
+					thisToothContourIndices[j].insert(thisToothContourIndices[j].begin(), toothContourIndices[no]);
 				break;
 			}
 	}
 	auto const& imageSize = thisBaseImage.size();
 	if (designImages)
 		(*designImages)[0] = Mat(imageSize, CV_8U, 255);
+	vector<vector<Point>> thisContours(nZones * nTeethPerZone);
+	float distance = 0;
 	for (auto zone = 0; zone < nZones; ++zone) {
+		auto const& teethContours = thisContours.begin() + zone * nTeethPerZone;
 		for (auto ordinal = 0; ordinal < nTeethPerZone - 1; ++ordinal) {
-			auto const& tooth = thisTeeth[zone][ordinal];
-			if (ordinal == nTeethPerZone - 2)
-				thisTeeth[zone].push_back(tooth);
+			auto& contour = teethContours[ordinal];
+			contour = move(contours[thisToothContourIndices[zone][ordinal]]);
 			if (designImages)
-				polylines((*designImages)[0], tooth.getContour(), true, 0, lineThicknessOfLevel[0], LINE_AA);
+				polylines((*designImages)[0], contour, true, 0, lineThicknessOfLevel[0], LINE_AA);
 		}
-		auto const& seventhTooth = thisTeeth[zone][nTeethPerZone - 2];
-		auto& eighthTooth = thisTeeth[zone][nTeethPerZone - 1];
-		auto const& translation = roundToPoint(rotate(computeNormalDirection(seventhTooth.getAnglePoint(180)), CV_PI * (zone % 2 - 0.5)) * seventhTooth.getRadius() * 2.16);
-		auto contour = eighthTooth.getContour();
-		for (auto point = contour.begin(); point < contour.end(); ++point)
+		auto const& seventhContour = teethContours[nTeethPerZone - 2];
+		auto& eighthContour = teethContours[nTeethPerZone - 1];
+		float radius;
+		computeCentroid(seventhContour, &radius);
+		auto const& translation = roundToPoint(rotate(computeNormalDirection(context, seventhContour[0]), CV_PI * (zone % 2 - 0.5)) * radius * 2.16);
+		eighthContour = seventhContour;
+		for (auto point = eighthContour.begin(); point < eighthContour.end(); ++point)
 			*point += translation;
-		eighthTooth.setContour(contour);
-		centroids.push_back(eighthTooth.getCentroid());
+		centroids.push_back(computeCentroid(eighthContour, &radius));
+		distance += radius;
 	}
-	teethEllipse = fitEllipse(centroids);
-	auto theta = degreeToRadian(teethEllipse.angle);
+	context.teethEllipse = fitEllipse(centroids);
+	auto theta = degreeToRadian(context.teethEllipse.angle);
 	auto const& direction = rotate(Point(0, 1), theta);
-	float distance = 0;
-	for (auto zone = 0; zone < nZones; ++zone)
-		distance += thisTeeth[zone][nTeethPerZone - 1].getRadius();
 	(distance *= 3) /= 4;
 	auto const& translation = roundToPoint(direction * distance);
+	vector<int> zones;
+	vector<Point2f> normalDirections;
+	vector<vector<Point>> remediedContours;
 	centroids.clear();
-	for (auto zone = 0; zone < nZones; ++zone) {
-		auto& teethZone = thisTeeth[zone];
-		auto& remediedTeethZone = remediedTeeth[zone];
-		remediedTeethZone.clear();
+	for (auto zone = 0; zone < nZones; ++zone)
 		for (auto ordinal = 0; ordinal < nTeethPerZone; ++ordinal) {
-			auto& tooth = teethZone[ordinal];
-			tooth.setNormalDirection(computeNormalDirection(tooth.getCentroid()));
+			auto& contour = thisContours[zone * nTeethPerZone + ordinal];
+			auto centroid = computeCentroid(contour);
+			zones.push_back(zone);
+			normalDirections.push_back(computeNormalDirection(context, centroid));
 			if (ordinal == nTeethPerZone - 1) {
-				auto contour = tooth.getContour();
-				auto& centroid = tooth.getCentroid();
-				theta = asin(teethZone[ordinal - 1].getNormalDirection().cross(tooth.getNormalDirection()));
+				theta = asin(normalDirections.rbegin()[1].cross(normalDirections.back()));
 				for (auto point = contour.begin(); point < contour.end(); ++point)
 					*point = centroid + rotate(static_cast<Point2f>(*point) - centroid, theta);
-				tooth.setContour(contour);
+				centroid = computeCentroid(contour);
 			}
-			auto remediedTooth = tooth;
+			remediedContours.push_back(contour);
 			if (zone >= nZones / 2) {
-				auto contour = remediedTooth.getContour();
-				for (auto point = contour.begin(); point < contour.end(); ++point)
+				auto& remediedContour = remediedContours.back();
+				for (auto point = remediedContour.begin(); point < remediedContour.end(); ++point)
 					*point += translation;
-				remediedTooth.setContour(contour);
+				centroid = computeCentroid(remediedContour);
 			}
-			centroids.push_back(remediedTooth.getCentroid());
-			remediedTeethZone.push_back(remediedTooth);
-			tooth.findAnglePoints(zone);
+			centroids.push_back(centroid);
 		}
-	}
 	if (teeth)
-		copy(begin(thisTeeth), end(thisTeeth), *teeth);
-	remediedTeethEllipse = fitEllipse(centroids);
-	theta = degreeToRadian(-remediedTeethEllipse.angle);
-	remediedTeethEllipse.angle = 0;
+		*teeth = TeethModel(thisContours, zones, normalDirections);
+	context.remediedTeethEllipse = fitEllipse(centroids);
+	theta = degreeToRadian(-context.remediedTeethEllipse.angle);
+	context.remediedTeethEllipse.angle = 0;
 	remediedDesignImages[0] = Mat(imageSize + Size(0, distance * cos(theta)), CV_8U, 255);
-	remedyImage = true;
-	for (auto zone = 0; zone < nZones; ++zone) {
+	context.isRemedied = true;
+	normalDirections.clear();
+	for (auto zone = 0; zone < nZones; ++zone)
 		for (auto ordinal = 0; ordinal < nTeethPerZone; ++ordinal) {
-			auto& tooth = remediedTeeth[zone][ordinal];
-			auto contour = tooth.getContour();
+			auto& contour = remediedContours[zone * nTeethPerZone + ordinal];
 			if (ordinal < nTeethPerZone - 1)
 				polylines(remediedDesignImages[0], contour, true, 0, lineThicknessOfLevel[0], LINE_AA);
 			for (auto point = contour.begin(); point < contour.end(); ++point)
-				*point = remediedTeethEllipse.center + rotate(static_cast<Point2f>(*point) - remediedTeethEllipse.center, theta);
-			tooth.setContour(contour);
-			tooth.setNormalDirection(computeNormalDirection(tooth.getCentroid()));
-			tooth.findAnglePoints(zone);
+				*point = context.remediedTeethEllipse.center + rotate(static_cast<Point2f>(*point) - context.remediedTeethEllipse.center, theta);
+			normalDirections.push_back(computeNormalDirection(context, computeCentroid(contour)));
 		}
-	}
-	remedyImage = oldRemedyImage;
+	remediedTeeth = TeethModel(remediedContours, zones, normalDirections);
+	context.isRemedied = false;
 }
 
-void updateDesign(vector<Tooth> (&teeth)[nZones], vector<Rpd*>& rpds, Mat (&designImages)[2], bool const& isRemedied, bool const& justLoadedImage, bool const& justLoadedRpds) {
-	auto oldRemedyImage = remedyImage;
-	remedyImage = isRemedied;
+void updateDesign(DesignContext const& context, TeethModel& teeth, RpdStore& rpds, DisplayList& displayList, bool const& isRemedied, bool const& justLoadedImage, bool const& justLoadedRpds, DesignGraph* const& designGraph) {
+	auto thisContext = context;
+	thisContext.isRemedied = isRemedied;
+	CurveCache curveCache;
+	if (!thisContext.curveCache)
+		thisContext.curveCache = &curveCache;
+	thisContext.curveCache->clear();
+	if (designGraph)
+		designGraph->beginUpdate(thisContext, rpds, justLoadedImage, justLoadedRpds);
 	if (!justLoadedImage)
-		for (auto zone = 0; zone < nZones; ++zone)
-			for (auto ordinal = 0; ordinal < nTeethPerZone; ++ordinal)
-				teeth[zone][ordinal].unsetAll();
-	for (auto rpd = rpds.begin(); rpd < rpds.end(); ++rpd) {
-		auto const& rpdAsMajorConnector = dynamic_cast<RpdAsMajorConnector*>(*rpd);
-		if (rpdAsMajorConnector) {
-			rpdAsMajorConnector->registerMajorConnector(teeth);
-			rpdAsMajorConnector->registerExpectedAnchors(teeth);
-			rpdAsMajorConnector->registerLingualConfrontations(teeth);
+		teeth.unsetFlags();
+	auto const& majorConnectors = rpds.getMajorConnectors();
+	for (auto majorConnector = majorConnectors.begin(); majorConnector < majorConnectors.end(); ++majorConnector) {
+		(*majorConnector)->registerMajorConnector(teeth);
+		(*majorConnector)->registerExpectedAnchors(teeth);
+		(*majorConnector)->registerLingualConfrontations(teeth);
+	}
+	auto const& rpdsWithClaspRootOrRest = rpds.getRpdsWithClaspRootOrRest();
+	for (auto rpd = rpdsWithClaspRootOrRest.begin(); rpd < rpdsWithClaspRootOrRest.end(); ++rpd)
+		(*rpd)->registerClaspRootOrRest(teeth);
+	auto const& dentureBases = rpds.getDentureBases();
+	for (auto dentureBase = dentureBases.begin(); dentureBase < dentureBases.end(); ++dentureBase)
+		(*dentureBase)->registerExpectedAnchors(teeth);
+	if (justLoadedRpds) {
+		auto const& rpdsWithLingualClaspArms = rpds.getRpdsWithLingualClaspArms();
+		for (auto rpd = rpdsWithLingualClaspArms.begin(); rpd < rpdsWithLingualClaspArms.end(); ++rpd) {
+			teeth.unsetReadFlags();
+			(*rpd)->setLingualClaspArms(teeth);
+			if (designGraph)
+				designGraph->registerSetup(teeth, rpds.indexOf(*rpd));
 		}
-		auto const& rpdWithClaspRootOrRest = dynamic_cast<RpdWithClaspRootOrRest*>(*rpd);
-		if (rpdWithClaspRootOrRest)
-			rpdWithClaspRootOrRest->registerClaspRootOrRest(teeth);
-		auto const& dentureBase = dynamic_cast<DentureBase*>(*rpd);
-		if (dentureBase)
-			dentureBase->registerExpectedAnchors(teeth);
+		for (auto dentureBase = dentureBases.begin(); dentureBase < dentureBases.end(); ++dentureBase) {
+			teeth.unsetReadFlags();
+			(*dentureBase)->setSide(thisContext, teeth);
+			if (designGraph)
+				designGraph->registerSetup(teeth, rpds.indexOf(*dentureBase));
+		}
+	}
+	auto const& rpdsWithLingualCoverage = rpds.getRpdsWithLingualCoverage();
+	for (auto rpd = rpdsWithLingualCoverage.begin(); rpd < rpdsWithLingualCoverage.end(); ++rpd)
+		(*rpd)->registerLingualCoverage(teeth);
+	for (auto dentureBase = dentureBases.begin(); dentureBase < dentureBases.end(); ++dentureBase)
+		(*dentureBase)->registerDentureBase(teeth);
+	DisplayList lastDisplayList;
+	if (designGraph)
+		lastDisplayList = displayList;
+	displayList.clear();
+	displayList.beginComponent();
+	for (auto zone = 0; zone < nZones; ++zone)
+		if (context.isEighthUsed[zone])
+			displayList.addPolyline(teeth[zone][nTeethPerZone - 1].getContour(), true, 0);
+	auto const& allRpds = rpds.getRpds();
+	for (auto rpd = allRpds.begin(); rpd < allRpds.end(); ++rpd) {
+		if (designGraph && designGraph->reuseComponent(teeth, rpd - allRpds.begin(), lastDisplayList, displayList))
+			continue;
+		teeth.unsetReadFlags();
+		displayList.beginComponent();
+		(*rpd)->draw(thisContext, displayList, teeth);
+		if (designGraph)
+			designGraph->registerDraw(teeth, rpd - allRpds.begin());
 	}
-	if (justLoadedRpds)
-		for (auto rpd = rpds.begin(); rpd < rpds.end(); ++rpd) {
-			auto const& rpdWithLingualArms = dynamic_cast<RpdWithLingualClaspArms*>(*rpd);
-			if (rpdWithLingualArms)
-				rpdWithLingualArms->setLingualClaspArms(teeth);
-			auto const& dentureBase = dynamic_cast<DentureBase*>(*rpd);
-			if (dentureBase)
-				dentureBase->setSide(teeth);
+	if (designGraph)
+		designGraph->endUpdate(lastDisplayList, displayList);
+}
+
+void rasterizeDesign(DisplayList const& displayList, Mat (&designImages)[2], DesignGraph const* const& designGraph) {
+	if (designGraph && designGraph->isIncremental() && designImages[1].size() == designImages[0].size()) {
+		auto const& dirtyComponents = designGraph->getDirtyComponents();
+		Rect dirtyRect;
+		for (auto component = 0; component < dirtyComponents.getNComponents(); ++component) {
+			auto const& componentRect = dirtyComponents.computeComponentRect(designImages[1].size(), component);
+			dirtyRect = dirtyRect.area() ? dirtyRect | componentRect : componentRect;
+		}
+		if (dirtyRect.area()) {
+			designImages[1](dirtyRect).setTo(255);
+			displayList.rasterize(designImages[1], dirtyRect);
 		}
-	for (auto rpd = rpds.begin(); rpd < rpds.end(); ++rpd) {
-		auto const& rpdWithLingualCoverage = dynamic_cast<RpdWithLingualCoverage*>(*rpd);
-		if (rpdWithLingualCoverage)
-			rpdWithLingualCoverage->registerLingualCoverage(teeth);
-		auto const& dentureBase = dynamic_cast<DentureBase*>(*rpd);
-		if (dentureBase)
-			dentureBase->registerDentureBase(teeth);
 	}
-	designImages[1] = Mat(designImages[0].size(), CV_8U, 255);
+	else {
+		designImages[1] = Mat(designImages[0].size(), CV_8U, 255);
+		displayList.rasterize(designImages[1]);
+	}
+}
+
+void exportDesign(TeethModel const& teeth, DisplayList const& displayList, Size const& imageSize, ostream& stream, bool const& asPdf) {
+	auto thisDisplayList = displayList;
+	thisDisplayList.beginComponent();
 	for (auto zone = 0; zone < nZones; ++zone)
-		if (Tooth::isEighthUsed[zone])
-			polylines(designImages[1], teeth[zone][nTeethPerZone - 1].getContour(), true, 0, lineThicknessOfLevel[0], LINE_AA);
-	for (auto rpd = rpds.begin(); rpd < rpds.end(); ++rpd)
-		(*rpd)->draw(designImages[1], teeth);
-	remedyImage = oldRemedyImage;
+		for (auto ordinal = 0; ordinal < nTeethPerZone - 1; ++ordinal)
+			thisDisplayList.addPolyline(teeth[zone][ordinal].getContour(), true, 0);
+	if (asPdf)
+		thisDisplayList.writePdf(stream, imageSize);
+	else
+		thisDisplayList.writeSvg(stream, imageSize);
 }
@@ -1,6 +1,12 @@
 #pragma once
 
-#include "Rpd.h"
+#include <iosfwd>
+
+#include "CurveCache.h"
+#include "JniRegistry.h"
+#include "RpdStore.h"
+
+class DesignGraph;
 
 float degreeToRadian(float const& degree);
 
@@ -15,54 +21,88 @@ Point2f normalize(Point_<T> const& point) { return static_cast<Point2f>(point) /
 template <typename T>
 Point roundToPoint(Point_<T> const& point) { return Point(round(point.x), round(point.y)); }
 
-void catPath(string& path, string const& searchDirectory, string const& extension);
-
 string getClsSig(const char* const& clsStr);
 
+streamoff computeRemainingSize(istream& stream);
+
 Rpd::Direction operator~(Rpd::Direction const& direction);
 
-Tooth const& getTooth(const vector<Tooth> (&teeth)[nZones], Rpd::Position const& position);
+Tooth const& getTooth(TeethModel const& teeth, Rpd::Position const& position);
+
+Tooth& getTooth(TeethModel& teeth, Rpd::Position const& position);
+
+int computeArchIndex(Rpd::Position const& position);
+
+uint32_t computeArchMask(Rpd::Position const& startPosition, Rpd::Position const& endPosition);
+
+bool isBlockedByMajorConnector(TeethModel const& teeth, vector<Rpd::Position> const& positions);
+
+void computeStringCurves(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, vector<vector<Point>>& curves, float* const& sumOfRadii = nullptr, int* const& nTeeth = nullptr, vector<Point>* const& distalPoints = nullptr);
+
+void computeStringCurves(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, CurveCache::StringCurves& stringCurves);
+
+void computeStringCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, float const& distanceScale, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, vector<Point>& curve, float* const& sumOfRadii = nullptr, int* const& nTeeth = nullptr, vector<Point>* const& distalPoints = nullptr);
+
+void computeInscribedCurve(DesignContext const& context, vector<Point> const& cornerPoints, vector<Point>& curve, float const& smoothness = 0.5F, bool const& shouldAppend = true);
+
+void computeSmoothCurve(DesignContext const& context, vector<Point> const& curve, vector<Point>& smoothCurve, bool const& isClosed = false, float const& smoothness = 0.5F);
+
+void computePiecewiseSmoothCurve(DesignContext const& context, vector<Point> const& curve, vector<Point>& piecewiseSmoothCurve, bool const& smoothStart = true, bool const& smoothEnd = true);
+
+void computeLingualCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve, vector<vector<Point>>& curves, vector<Point>* const& distalPoints = nullptr, const vector<Point>* const& anchorPoints = nullptr);
+
+void computeLingualCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve, vector<vector<Point>>& curves, Point& distalPoint, const vector<Point>* const& anchorPoints = nullptr);
+
+void computeMesialCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve, vector<int>& mesialOrdinals, vector<Point>* const& innerCurve = nullptr);
+
+void computeDistalCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point> const& distalPoints, vector<Point>& curve, const vector<int>* const& mesialOrdinals = nullptr, vector<Point>* const& innerCurve = nullptr);
+
+void computeInnerCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, float const& avgRadius, vector<Point>& curve, vector<vector<Point>>& curves, const vector<Point>* const& anchorPoints = nullptr);
+
+void computeOuterCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve, float* const& avgRadius = nullptr);
+
+void computeLingualConfrontationCurve(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Point>& curve);
 
-Tooth& getTooth(vector<Tooth> (&teeth)[nZones], Rpd::Position const& position);
+void computeLingualConfrontationCurves(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<vector<Point>>& curves);
 
-bool isBlockedByMajorConnector(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions);
+Point2f computeCentroid(vector<Point> const& contour, float* const& radius = nullptr);
 
-void computeStringCurves(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, vector<vector<Point>>& curves, float* const& sumOfRadii = nullptr, int* const& nTeeth = nullptr, vector<Point>* const& distalPoints = nullptr);
+Point2f computeNormalDirection(DesignContext const& context, Point2f const& point, float* const& angle = nullptr);
 
-void computeStringCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, float const& distanceScale, deque<bool> const& keepStartEndPoints, deque<bool> const& considerAnchorDisplacements, bool const& considerDistalPoints, vector<Point>& curve, float* const& sumOfRadii = nullptr, int* const& nTeeth = nullptr, vector<Point>* const& distalPoints = nullptr);
+void computeNormalDirections(DesignContext const& context, vector<Point> const& points, vector<Point2f>& normalDirections);
 
-void computeInscribedCurve(vector<Point> const& cornerPoints, vector<Point>& curve, float const& smoothness = 0.5F, bool const& shouldAppend = true);
+void computeOffsetCurves(DesignContext const& context, vector<Point> const& curve, float const& distance, vector<float> const& distanceScales, deque<bool> const& keepStartEndPoints, vector<vector<Point>>& curves);
 
-void computeSmoothCurve(vector<Point> const& curve, vector<Point>& smoothCurve, bool const& isClosed = false, float const& smoothness = 0.5F);
+bool shouldAnchor(DesignContext const& context, TeethModel const& teeth, Rpd::Position const& position, Rpd::Direction const& direction);
 
-void computePiecewiseSmoothCurve(vector<Point> const& curve, vector<Point>& piecewiseSmoothCurve, bool const& smoothStart = true, bool const& smoothEnd = true);
+void findAnchorPoints(DesignContext const& context, TeethModel const& teeth, vector<Rpd::Position> const& positions, vector<Rpd::Position>& startEndPositions, const vector<Point>* const& inAnchorPoints = nullptr, vector<Point>* const& outAnchorPoints = nullptr);
 
-void computeLingualCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve, vector<vector<Point>>& curves, vector<Point>* const& distalPoints = nullptr, const vector<Point>* const& anchorPoints = nullptr);
+bool isLastTooth(DesignContext const& context, Rpd::Position const& position);
 
-void computeLingualCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve, vector<vector<Point>>& curves, Point& distalPoint, const vector<Point>* const& anchorPoints = nullptr);
+int queryInt(JNIEnv* const& env, JniRegistry const& registry, jobject const& property, jobject const& individual);
 
-void computeMesialCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve, vector<int>& mesialOrdinals, vector<Point>* const& innerCurve = nullptr);
+int queryBoolean(JNIEnv* const& env, JniRegistry const& registry, jobject const& property, jobject const& individual);
 
-void computeDistalCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point> const& distalPoints, vector<Point>& curve, const vector<int>* const& mesialOrdinals = nullptr, vector<Point>* const& innerCurve = nullptr);
+bool queryPositions(JNIEnv* const& env, JniRegistry const& registry, jobject const& property, jobject const& individual, vector<Rpd::Position>& positions);
 
-void computeInnerCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, float const& avgRadius, vector<Point>& curve, vector<vector<Point>>& curves, const vector<Point>* const& anchorPoints = nullptr);
+bool createRpds(vector<Individual> const& individuals, RpdStore& rpds, bool (&isEighthToothUsed)[nZones]);
 
-void computeOuterCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve, float* const& avgRadius = nullptr);
+bool queryIndividual(JNIEnv* const& env, JniRegistry const& registry, jobject const& jIndividual, Individual& individual);
 
-void computeLingualConfrontationCurve(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Point>& curve);
+bool queryIndividuals(JNIEnv* const& env, JniRegistry const& registry, jobject const& ontModel, vector<Individual>& individuals);
 
-void computeLingualConfrontationCurves(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<vector<Point>>& curves);
+bool isValidFlattening(vector<jint> const (&columns)[N_FLATTENED_COLUMNS], size_t const& nClasses);
 
-Point2f computeNormalDirection(Point2f const& point, float* const& angle = nullptr);
+bool queryIndividualsInBulk(JNIEnv* const& env, JniRegistry const& registry, jobject const& ontModel, vector<Individual>& individuals);
 
-bool shouldAnchor(const vector<Tooth> (&teeth)[nZones], Rpd::Position const& position, Rpd::Direction const& direction);
+bool queryRpds(JNIEnv* const& env, jobject const& ontModel, RpdStore& rpds, bool (&isEighthToothUsed)[nZones]);
 
-void findAnchorPoints(const vector<Tooth> (&teeth)[nZones], vector<Rpd::Position> const& positions, vector<Rpd::Position>& startEndPositions, const vector<Point>* const& inAnchorPoints = nullptr, vector<Point>* const& outAnchorPoints = nullptr);
+bool queryRpds(string const& fileName, RpdStore& rpds, bool (&isEighthToothUsed)[nZones]);
 
-bool isLastTooth(Rpd::Position const& position);
+void analyzeBaseImage(Mat const& image, DesignContext& context, TeethModel& remediedTeeth, Mat (&remediedDesignImages)[2], TeethModel* const& teeth = nullptr, Mat (*const& designImages)[2] = nullptr, Mat* const& baseImage = nullptr);
 
-bool queryRpds(JNIEnv* const& env, jobject const& ontModel, vector<Rpd*>& rpds);
+void updateDesign(DesignContext const& context, TeethModel& teeth, RpdStore& rpds, DisplayList& displayList, bool const& isRemedied, bool const& justLoadedImage, bool const& justLoadedRpds, DesignGraph* const& designGraph = nullptr);
 
-void analyzeBaseImage(Mat const& image, vector<Tooth> (&remediedTeeth)[nZones], Mat (&remediedDesignImages)[2], vector<Tooth> (*const& teeth)[nZones] = nullptr, Mat (*const& designImages)[2] = nullptr, Mat* const& baseImage = nullptr);
+void rasterizeDesign(DisplayList const& displayList, Mat (&designImages)[2], DesignGraph const* const& designGraph = nullptr);
 
-void updateDesign(vector<Tooth> (&teeth)[nZones], vector<Rpd*>& rpds, Mat (&designImages)[2], bool const& isRemedied, bool const& justLoadedImage, bool const& justLoadedRpds);
+void exportDesign(TeethModel const& teeth, DisplayList const& displayList, Size const& imageSize, ostream& stream, bool const& asPdf = false);
@@ -0,0 +1,33 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(size_t const& nWorkers) {
+	for (size_t i = 0; i < max<size_t>(nWorkers, 1); ++i)
+		workers_.push_back(thread(&WorkerPool::work, this));
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		lock_guard<mutex> lock(mutex_);
+		isStopping_ = true;
+	}
+	condition_.notify_all();
+	for (auto worker = workers_.begin(); worker < workers_.end(); ++worker)
+		worker->join();
+}
+
+size_t WorkerPool::getSize() const { return workers_.size(); }
+
+void WorkerPool::work() {
+	while (true) {
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(mutex_);
+			condition_.wait(lock, [this] { return isStopping_ || !tasks_.empty(); });
+			if (tasks_.empty())
+				return;
+			task = move(tasks_.front());
+			tasks_.pop();
+		}
+		task();
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class WorkerPool {
+public:
+	explicit WorkerPool(size_t const& nWorkers = thread::hardware_concurrency());
+	~WorkerPool();
+	size_t getSize() const;
+	template <typename F>
+	future<result_of_t<F()>> submit(F&& task);
+private:
+	void work();
+	bool isStopping_ = false;
+	condition_variable condition_;
+	mutex mutex_;
+	queue<function<void()>> tasks_;
+	vector<thread> workers_;
+};
+
+template <typename F>
+future<result_of_t<F()>> WorkerPool::submit(F&& task) {
+	auto const& packagedTask = make_shared<packaged_task<result_of_t<F()>()>>(forward<F>(task));
+	auto result = packagedTask->get_future();
+	{
+		lock_guard<mutex> lock(mutex_);
+		tasks_.push([packagedTask] { (*packagedTask)(); });
+	}
+	condition_.notify_one();
+	return result;
+}
@@ -77,8 +77,8 @@
     </message>
     <message>
         <location filename="RpdDesign.cpp" line="109"/>
-        <source>Ontology files (*.owl)</source>
-        <translation>Ontology files (*.owl)</translation>
+        <source>Ontology files (*.owl);;Design specs (*.rpds)</source>
+        <translation>Ontology files (*.owl);;Design specs (*.rpds)</translation>
     </message>
     <message>
         <location filename="RpdDesign.cpp" line="134"/>
@@ -92,8 +92,8 @@
     </message>
     <message>
         <location filename="RpdDesign.cpp" line="160"/>
-        <source>Windows bitmaps (*.bmp *.dib);;JPEG files (*.jpeg *.jpg *.jpe);;JPEG 2000 files (*.jp2);;Portable Network Graphics (*.png);;Portable image format (*.pbm *.pgm *.ppm);;Sun rasters (*.sr *.ras);;TIFF files (*.tiff *.tif)</source>
-        <translation>Windows bitmaps (*.bmp *.dib);;JPEG files (*.jpeg *.jpg *.jpe);;JPEG 2000 files (*.jp2);;Portable Network Graphics (*.png);;Portable image format (*.pbm *.pgm *.ppm);;Sun rasters (*.sr *.ras);;TIFF files (*.tiff *.tif)</translation>
+        <source>Windows bitmaps (*.bmp *.dib);;JPEG files (*.jpeg *.jpg *.jpe);;JPEG 2000 files (*.jp2);;Portable Network Graphics (*.png);;Portable image format (*.pbm *.pgm *.ppm);;Sun rasters (*.sr *.ras);;TIFF files (*.tiff *.tif);;Scalable Vector Graphics (*.svg);;Portable Document Format (*.pdf)</source>
+        <translation>Windows bitmaps (*.bmp *.dib);;JPEG files (*.jpeg *.jpg *.jpe);;JPEG 2000 files (*.jp2);;Portable Network Graphics (*.png);;Portable image format (*.pbm *.pgm *.ppm);;Sun rasters (*.sr *.ras);;TIFF files (*.tiff *.tif);;Scalable Vector Graphics (*.svg);;Portable Document Format (*.pdf)</translation>
     </message>
     <message>
         <location filename="RpdDesign.cpp" line="160"/>
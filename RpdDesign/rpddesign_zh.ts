@@ -77,8 +77,8 @@
     </message>
     <message>
         <location filename="RpdDesign.cpp" line="109"/>
-        <source>Ontology files (*.owl)</source>
-        <translation>本体文件 (*.owl)</translation>
+        <source>Ontology files (*.owl);;Design specs (*.rpds)</source>
+        <translation>本体文件 (*.owl);;设计规格文件 (*.rpds)</translation>
     </message>
     <message>
         <location filename="RpdDesign.cpp" line="134"/>
@@ -92,8 +92,8 @@
     </message>
     <message>
         <location filename="RpdDesign.cpp" line="160"/>
-        <source>Windows bitmaps (*.bmp *.dib);;JPEG files (*.jpeg *.jpg *.jpe);;JPEG 2000 files (*.jp2);;Portable Network Graphics (*.png);;Portable image format (*.pbm *.pgm *.ppm);;Sun rasters (*.sr *.ras);;TIFF files (*.tiff *.tif)</source>
-        <translation>Windows位图 (*.bmp *.dib);;JPEG文件 (*.jpeg *.jpg *.jpe);;JPEG 2000文件 (*.jp2);;便携式网络图形 (*.png);;便携式图像格式 (*.pbm *.pgm *.ppm);;Sun栅格图 (*.sr *.ras);;TIFF文件 (*.tiff *.tif)</translation>
+        <source>Windows bitmaps (*.bmp *.dib);;JPEG files (*.jpeg *.jpg *.jpe);;JPEG 2000 files (*.jp2);;Portable Network Graphics (*.png);;Portable image format (*.pbm *.pgm *.ppm);;Sun rasters (*.sr *.ras);;TIFF files (*.tiff *.tif);;Scalable Vector Graphics (*.svg);;Portable Document Format (*.pdf)</source>
+        <translation>Windows位图 (*.bmp *.dib);;JPEG文件 (*.jpeg *.jpg *.jpe);;JPEG 2000文件 (*.jp2);;便携式网络图形 (*.png);;便携式图像格式 (*.pbm *.pgm *.ppm);;Sun栅格图 (*.sr *.ras);;TIFF文件 (*.tiff *.tif);;可缩放矢量图形 (*.svg);;便携式文档格式 (*.pdf)</translation>
     </message>
     <message>
         <location filename="RpdDesign.cpp" line="160"/>
@@ -0,0 +1,483 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <opencv2/core/utility.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include <sstream>
+
+#include "../RpdDesign/CurveCache.h"
+#include "../RpdDesign/DesignGraph.h"
+#include "../RpdDesign/DesignSpec.h"
+#include "../RpdDesign/DisplayList.h"
+#include "../RpdDesign/OwlReader.h"
+#include "../RpdDesign/TeethModel.h"
+#include "../RpdDesign/Utilities.h"
+
+void writeFloats(ostream& stream, float const* const& values, int const& nValues) {
+	stream << '{';
+	for (auto i = 0; i < nValues; ++i)
+		stream << (i ? ", " : "") << values[i] << 'f';
+	stream << '}';
+}
+
+bool writeDefaultBase(string const& baseFileName, string const& dataFileName) {
+	auto const& base = imread(baseFileName, IMREAD_COLOR);
+	if (base.empty())
+		return false;
+	TeethModel teeth[2];
+	Mat designImages[2][2];
+	DesignContext context;
+	analyzeBaseImage(base, context, teeth[1], designImages[1], &teeth[0], &designImages[0]);
+	RotatedRect const ellipses[]{context.teethEllipse, context.remediedTeethEllipse};
+	ofstream stream(dataFileName);
+	stream << scientific << setprecision(9);
+	stream << "int const imageWidth = " << designImages[0][0].cols << ", imageHeight = " << designImages[0][0].rows << ", remediedImageHeight = " << designImages[1][0].rows << ";\n\n";
+	stream << "float const ellipses[2][5]{";
+	for (auto set = 0; set < 2; ++set) {
+		auto const& ellipse = ellipses[set];
+		float const values[]{ellipse.center.x, ellipse.center.y, ellipse.size.width, ellipse.size.height, ellipse.angle};
+		stream << (set ? ", " : "");
+		writeFloats(stream, values, 5);
+	}
+	stream << "};\n\nfloat const toothScalars[2][" << nZones * nTeethPerZone << "][5]{";
+	for (auto set = 0; set < 2; ++set) {
+		stream << (set ? "}, {" : "{");
+		for (auto zone = 0; zone < nZones; ++zone)
+			for (auto ordinal = 0; ordinal < nTeethPerZone; ++ordinal) {
+				auto const& tooth = teeth[set][zone][ordinal];
+				float const values[]{tooth.getRadius(), tooth.getCentroid().x, tooth.getCentroid().y, tooth.getNormalDirection().x, tooth.getNormalDirection().y};
+				stream << (zone || ordinal ? ",\n\t" : "\n\t");
+				writeFloats(stream, values, 5);
+			}
+	}
+	stream << "}};\n\nint const anglePointIndices[2][" << nZones * nTeethPerZone << "][360]{";
+	for (auto set = 0; set < 2; ++set) {
+		stream << (set ? "}, {" : "{");
+		for (auto zone = 0; zone < nZones; ++zone)
+			for (auto ordinal = 0; ordinal < nTeethPerZone; ++ordinal) {
+				auto const& indices = teeth[set][zone][ordinal].getAnglePointIndices();
+				stream << (zone || ordinal ? ",\n\t{" : "\n\t{");
+				for (auto it = indices.begin(); it < indices.end(); ++it)
+					stream << (it == indices.begin() ? "" : ", ") << *it;
+				stream << '}';
+			}
+	}
+	size_t nPoints = 0;
+	stream << "}};\n\nint const contourOffsets[2][" << nZones * nTeethPerZone + 1 << "]{";
+	for (auto set = 0; set < 2; ++set) {
+		stream << (set ? "}, {" : "{") << nPoints;
+		for (auto zone = 0; zone < nZones; ++zone)
+			for (auto ordinal = 0; ordinal < nTeethPerZone; ++ordinal)
+				stream << ", " << (nPoints += teeth[set][zone][ordinal].getContour().size());
+	}
+	stream << "}};\n\nint const contourPoints[][2]{";
+	for (auto set = 0; set < 2; ++set)
+		for (auto zone = 0; zone < nZones; ++zone)
+			for (auto ordinal = 0; ordinal < nTeethPerZone; ++ordinal) {
+				auto const& contour = teeth[set][zone][ordinal].getContour();
+				stream << (set || zone || ordinal ? ",\n\t" : "\n\t");
+				for (auto point = contour.begin(); point < contour.end(); ++point)
+					stream << (point == contour.begin() ? "{" : ", {") << point->x << ", " << point->y << '}';
+			}
+	size_t nRuns = 0;
+	stringstream runs;
+	stream << "\n};\n\nint const outlineRunOffsets[3]{0";
+	for (auto set = 0; set < 2; ++set) {
+		auto const& outline = designImages[set][0];
+		auto const& data = outline.data;
+		size_t const& size = outline.total();
+		for (size_t i = 0, j; i < size; i = j, ++nRuns) {
+			for (j = i + 1; j < size && j - i < UINT16_MAX && data[j] == data[i]; ++j);
+			runs << (nRuns % 8 ? ", {" : nRuns ? ",\n\t{" : "\n\t{") << static_cast<int>(data[i]) << ", " << j - i << '}';
+		}
+		stream << ", " << nRuns;
+	}
+	stream << "};\n\nuint16_t const outlineRuns[][2]{" << runs.str() << "\n};\n";
+	return static_cast<bool>(stream);
+}
+
+void findAnglePointsReference(vector<Point>& contour, vector<int>& anglePointIndices, Point2f const& centroid, Point2f const& normalDirection, int const& zone) {
+	auto const& signVal = 1 - zone % 2 * 2;
+	auto const& deltaAngle = degreeToRadian(1);
+	int angle;
+	float targetAngle;
+	if (signVal == 1) {
+		angle = 0;
+		targetAngle = CV_PI / 2;
+	}
+	else {
+		angle = 359;
+		targetAngle = CV_PI / 2 * 3 - deltaAngle;
+	}
+	auto nPoints = contour.size();
+	auto j = 0;
+	while (angle >= 0 && angle < 360) {
+		auto isFound = false;
+		auto const& d = rotate(normalDirection, targetAngle);
+		while (!isFound) {
+			auto const& p1 = contour[j];
+			auto const& p2 = contour[(j + 1) % nPoints];
+			auto const& t = d.cross(centroid - static_cast<Point2f>(p1)) / d.cross(p2 - p1);
+			if (t >= 0 && t < 1) {
+				auto const& point = p1 + t * (p2 - p1);
+				if (d.dot(static_cast<Point2f>(point) - centroid) > 0) {
+					if (point == p1)
+						anglePointIndices[angle] = j;
+					else if (point == p2)
+						anglePointIndices[angle] = (j + 1) % nPoints;
+					else {
+						contour.insert(contour.begin() + ++j, point);
+						++nPoints;
+						for (auto k = 0; k < 360; ++k)
+							if (anglePointIndices[k] >= j)
+								++anglePointIndices[k];
+						anglePointIndices[angle] = j--;
+					}
+					isFound = true;
+				}
+			}
+			if (!isFound)
+				j = (j + 1) % nPoints;
+		}
+		angle += signVal;
+		targetAngle -= deltaAngle;
+	}
+}
+
+bool benchmarkAnglePoints(Mat const& base, double const& scale) {
+	Mat tmpImage;
+	resize(base, tmpImage, Size(), scale, scale, INTER_CUBIC);
+	copyMakeBorder(tmpImage, tmpImage, 80, 80, 80, 80, BORDER_CONSTANT, Scalar::all(255));
+	threshold(tmpImage, tmpImage, 0, 255, THRESH_BINARY | THRESH_OTSU);
+	vector<vector<Point>> contours;
+	vector<Vec4i> hierarchy;
+	findContours(tmpImage, contours, hierarchy, RETR_TREE, CHAIN_APPROX_SIMPLE);
+	vector<vector<Point>> toothContours;
+	vector<Point2f> centroids;
+	Point2f center;
+	size_t nPoints = 0;
+	for (auto i = hierarchy[0][2]; i >= 0; i = hierarchy[i][0])
+		for (auto j = hierarchy[i][2]; j >= 0; j = hierarchy[j][0]) {
+			toothContours.push_back(contours[j]);
+			centroids.push_back(computeCentroid(contours[j]));
+			center += centroids.back();
+			nPoints += contours[j].size();
+		}
+	auto const& nTeeth = static_cast<int>(toothContours.size());
+	center /= static_cast<float>(nTeeth);
+	vector<vector<Point>> modelContours;
+	vector<int> zones;
+	vector<Point2f> normalDirections;
+	for (auto no = 0; no < nTeeth; ++no)
+		for (auto zone = 0; zone < 2; ++zone) {
+			auto const& direction = centroids[no] - center;
+			modelContours.push_back(toothContours[no]);
+			zones.push_back(zone);
+			normalDirections.push_back(direction / norm(direction));
+		}
+	auto const& nRounds = 20;
+	chrono::duration<double, micro> referenceTime(0), sweepTime(0);
+	for (auto round = 0; round < nRounds; ++round) {
+		TeethModel teeth(modelContours, zones, normalDirections);
+		for (auto tooth = teeth.begin(); tooth < teeth.end(); ++tooth) {
+			auto const& no = tooth - teeth.begin();
+			auto referenceContour = modelContours[no];
+			vector<int> referenceIndices(360);
+			auto const& startTime = chrono::steady_clock::now();
+			findAnglePointsReference(referenceContour, referenceIndices, tooth->getCentroid(), tooth->getNormalDirection(), zones[no]);
+			auto const& midTime = chrono::steady_clock::now();
+			tooth->getAnglePoint(0);
+			auto const& endTime = chrono::steady_clock::now();
+			referenceTime += midTime - startTime;
+			sweepTime += endTime - midTime;
+			if (tooth->getContour() != referenceContour || tooth->getAnglePointIndices() != referenceIndices)
+				return false;
+		}
+	}
+	auto const& nRuns = nRounds * nTeeth * 2;
+	cout << fixed << setprecision(1) << "Scale " << scale << ": " << nTeeth << " teeth, " << static_cast<double>(nPoints) / nTeeth << " points per tooth" << endl;
+	cout << "  reference " << referenceTime.count() / nRuns << " us, sweep " << sweepTime.count() / nRuns << " us per tooth (" << referenceTime.count() / sweepTime.count() << "x)" << endl;
+	return true;
+}
+
+Point2f computeNormalDirectionReference(RotatedRect const& ellipse, Point2f const& point) {
+	auto const& direction = point - ellipse.center;
+	auto const& angle = atan2(direction.y, direction.x) - degreeToRadian(ellipse.angle);
+	return normalize(Point2f(pow(ellipse.size.height, 2) * cos(angle), pow(ellipse.size.width, 2) * sin(angle)));
+}
+
+bool benchmarkNormals(Mat const& base) {
+	TeethModel teeth[2];
+	Mat designImages[2][2];
+	DesignContext context;
+	analyzeBaseImage(base, context, teeth[1], designImages[1], &teeth[0], &designImages[0]);
+	auto const& nRounds = 200;
+	auto const& maxError = 1e-5;
+	chrono::duration<double, micro> referenceTime(0), scalarTime(0), batchTime(0);
+	double error = 0;
+	size_t nPoints = 0;
+	auto isConsistent = true;
+	for (auto set = 0; set < 2; ++set) {
+		context.isRemedied = set;
+		auto const& ellipse = context.getTeethEllipse();
+		for (auto tooth = teeth[set].begin(); tooth < teeth[set].end(); ++tooth) {
+			auto const& contour = tooth->getContour();
+			vector<Point2f> referenceNormalDirections(contour.size()), scalarNormalDirections(contour.size()), batchNormalDirections;
+			for (auto round = 0; round < nRounds; ++round) {
+				auto const& startTime = chrono::steady_clock::now();
+				for (auto i = 0; i < contour.size(); ++i)
+					referenceNormalDirections[i] = computeNormalDirectionReference(ellipse, contour[i]);
+				auto const& scalarStartTime = chrono::steady_clock::now();
+				for (auto i = 0; i < contour.size(); ++i)
+					scalarNormalDirections[i] = computeNormalDirection(context, contour[i]);
+				auto const& batchStartTime = chrono::steady_clock::now();
+				computeNormalDirections(context, contour, batchNormalDirections);
+				auto const& endTime = chrono::steady_clock::now();
+				referenceTime += scalarStartTime - startTime;
+				scalarTime += batchStartTime - scalarStartTime;
+				batchTime += endTime - batchStartTime;
+			}
+			for (auto i = 0; i < contour.size(); ++i) {
+				error = max(error, abs(asin(min(max(static_cast<double>(referenceNormalDirections[i].cross(batchNormalDirections[i])), -1.), 1.))));
+				isConsistent = isConsistent && scalarNormalDirections[i] == batchNormalDirections[i];
+			}
+			nPoints += contour.size();
+		}
+	}
+	auto const& nRuns = nRounds * nPoints / 1000.;
+	cout << scientific << setprecision(2) << nPoints << " points, max deviation from the trigonometric normals " << error << " rad (bound " << maxError << ')' << endl;
+	cout << fixed << setprecision(1) << "  reference " << referenceTime.count() / nRuns << " us, scalar " << scalarTime.count() / nRuns << " us, batch " << batchTime.count() / nRuns << " us per 1000 points" << endl;
+	return isConsistent && error <= maxError;
+}
+
+bool recordDesign(Mat const& base, string const& rpdFileName, double const& scale, DisplayList& displayList, Size& imageSize) {
+	TeethModel teeth;
+	Mat designImages[2];
+	DesignContext context;
+	analyzeBaseImage(base, context, teeth, designImages);
+	RpdStore rpds;
+	if (!queryRpds(rpdFileName, rpds, context.isEighthUsed))
+		return false;
+	updateDesign(context, teeth, rpds, displayList, true, true, true);
+	imageSize = Size(static_cast<int>(round(designImages[0].cols * scale)), static_cast<int>(round(designImages[0].rows * scale)));
+	return true;
+}
+
+bool benchmarkShades(Mat const& base, string const& rpdFileName, double const& scale) {
+	DisplayList displayList;
+	Size imageSize;
+	if (!recordDesign(base, rpdFileName, scale, displayList, imageSize))
+		return false;
+	vector<Rect> shadeRects;
+	displayList.computeShadeRects(imageSize, shadeRects, static_cast<float>(scale));
+	int64_t nClippedPixels = 0;
+	for (auto shadeRect = shadeRects.begin(); shadeRect < shadeRects.end(); ++shadeRect)
+		nClippedPixels += shadeRect->area();
+	auto const& nFullPixels = static_cast<int64_t>(shadeRects.size()) * imageSize.area();
+	auto const& nRounds = 20;
+	chrono::duration<double, milli> fullTime(0), clippedTime(0);
+	Mat fullImage, clippedImage;
+	for (auto round = 0; round < nRounds; ++round) {
+		fullImage = Mat(imageSize, CV_8U, 255);
+		clippedImage = Mat(imageSize, CV_8U, 255);
+		auto const& startTime = chrono::steady_clock::now();
+		displayList.rasterize(fullImage, static_cast<float>(scale), Point2f(), false, false);
+		auto const& midTime = chrono::steady_clock::now();
+		displayList.rasterize(clippedImage, static_cast<float>(scale));
+		auto const& endTime = chrono::steady_clock::now();
+		fullTime += midTime - startTime;
+		clippedTime += endTime - midTime;
+	}
+	cout << fixed << setprecision(1) << "Scale " << scale << ": " << imageSize.width << 'x' << imageSize.height << ", " << shadeRects.size() << " shaded layers" << endl;
+	cout << "  full-frame " << shadeRects.size() << " allocations, " << nFullPixels << " pixels composited, " << fullTime.count() / nRounds << " ms" << endl;
+	cout << "  clipped " << (shadeRects.empty() ? 0 : 1) << " allocations, " << nClippedPixels << " pixels composited (" << (nFullPixels ? 100. * nClippedPixels / nFullPixels : 0) << "%), " << clippedTime.count() / nRounds << " ms" << endl;
+	return countNonZero(fullImage != clippedImage) == 0;
+}
+
+bool benchmarkParallel(Mat const& base, string const& rpdFileName, double const& scale) {
+	DisplayList displayList;
+	Size imageSize;
+	if (!recordDesign(base, rpdFileName, scale, displayList, imageSize))
+		return false;
+	auto const& nRounds = 20;
+	chrono::duration<double, milli> serialTime(0), parallelTime(0);
+	Mat serialImage, parallelImage, directImage(imageSize, CV_8U, 255);
+	for (auto round = 0; round < nRounds; ++round) {
+		serialImage = Mat(imageSize, CV_8U, 255);
+		parallelImage = Mat(imageSize, CV_8U, 255);
+		auto const& startTime = chrono::steady_clock::now();
+		displayList.rasterize(serialImage, static_cast<float>(scale), Point2f(), true, false);
+		auto const& midTime = chrono::steady_clock::now();
+		displayList.rasterize(parallelImage, static_cast<float>(scale));
+		auto const& endTime = chrono::steady_clock::now();
+		serialTime += midTime - startTime;
+		parallelTime += endTime - midTime;
+	}
+	for (auto component = 0; component < displayList.getNComponents(); ++component)
+		displayList.rasterize(directImage, component, static_cast<float>(scale));
+	cout << fixed << setprecision(1) << "Scale " << scale << ": " << imageSize.width << 'x' << imageSize.height << ", " << displayList.getNComponents() << " components, " << getNumThreads() << " threads" << endl;
+	cout << "  serial " << serialTime.count() / nRounds << " ms, parallel " << parallelTime.count() / nRounds << " ms (" << serialTime.count() / parallelTime.count() << "x)" << endl;
+	auto const& nSerialDifferences = countNonZero(serialImage != directImage), nParallelDifferences = countNonZero(parallelImage != directImage);
+	cout << "  serial " << nSerialDifferences << " pixels, parallel " << nParallelDifferences << " pixels differ from drawing every component straight onto the image" << endl;
+	return nSerialDifferences == 0 && nParallelDifferences == 0;
+}
+
+bool benchmarkIncremental(Mat const& base, string const& rpdFileName) {
+	TeethModel teeth;
+	Mat designImages[2];
+	DesignContext context;
+	analyzeBaseImage(base, context, teeth, designImages);
+	vector<Individual> individuals;
+	RpdStore rpds;
+	if (!(DesignSpec::read(rpdFileName, individuals) || OwlReader::read(rpdFileName, individuals)) || !createRpds(individuals, rpds, context.isEighthUsed))
+		return false;
+	auto incrementalTeeth = teeth, fullTeeth = teeth;
+	Mat incrementalImages[2]{designImages[0]}, fullImages[2]{designImages[0]};
+	DisplayList incrementalDisplayList, fullDisplayList;
+	DesignGraph designGraph;
+	updateDesign(context, incrementalTeeth, rpds, incrementalDisplayList, true, true, true, &designGraph);
+	rasterizeDesign(incrementalDisplayList, incrementalImages, &designGraph);
+	chrono::duration<double, milli> incrementalTime(0), fullTime(0);
+	auto nUpdates = 0, nDirtyComponents = 0, nComponents = 0;
+	auto isIdentical = true;
+	for (auto omitted = 0; omitted <= individuals.size(); ++omitted) {
+		if (omitted < individuals.size() && individuals[omitted].rpdClass == TOOTH)
+			continue;
+		auto thisIndividuals = individuals;
+		if (omitted < individuals.size())
+			thisIndividuals.erase(thisIndividuals.begin() + omitted);
+		auto thisContext = context;
+		RpdStore incrementalRpds, fullRpds;
+		if (!createRpds(thisIndividuals, incrementalRpds, thisContext.isEighthUsed) || !createRpds(thisIndividuals, fullRpds, thisContext.isEighthUsed))
+			continue;
+		auto const& startTime = chrono::steady_clock::now();
+		updateDesign(thisContext, incrementalTeeth, incrementalRpds, incrementalDisplayList, true, false, true, &designGraph);
+		rasterizeDesign(incrementalDisplayList, incrementalImages, &designGraph);
+		auto const& midTime = chrono::steady_clock::now();
+		updateDesign(thisContext, fullTeeth, fullRpds, fullDisplayList, true, false, true);
+		rasterizeDesign(fullDisplayList, fullImages);
+		auto const& endTime = chrono::steady_clock::now();
+		incrementalTime += midTime - startTime;
+		fullTime += endTime - midTime;
+		++nUpdates;
+		nDirtyComponents += designGraph.isIncremental() ? designGraph.getDirtyComponents().getNComponents() : fullDisplayList.getNComponents();
+		nComponents += fullDisplayList.getNComponents();
+		isIdentical = isIdentical && countNonZero(incrementalImages[1] != fullImages[1]) == 0;
+	}
+	if (!nUpdates)
+		return false;
+	cout << fixed << setprecision(1) << nUpdates << " updates, each leaving out another component, " << static_cast<double>(nDirtyComponents) / nUpdates << " of " << static_cast<double>(nComponents) / nUpdates << " components invalidated on average" << endl;
+	cout << "  incremental " << incrementalTime.count() / nUpdates << " ms, full " << fullTime.count() / nUpdates << " ms per update (" << fullTime.count() / incrementalTime.count() << "x)" << endl;
+	return isIdentical;
+}
+
+bool benchmarkCurveCache(Mat const& base, string const& rpdFileName) {
+	TeethModel teeth;
+	Mat designImages[2];
+	DesignContext context;
+	analyzeBaseImage(base, context, teeth, designImages);
+	vector<Individual> individuals;
+	RpdStore rpds;
+	if (!(DesignSpec::read(rpdFileName, individuals) || OwlReader::read(rpdFileName, individuals)) || !createRpds(individuals, rpds, context.isEighthUsed))
+		return false;
+	auto const& nRounds = 20;
+	CurveCache cachedCurves, uncachedCurves(false);
+	auto cachedContext = context, uncachedContext = context;
+	cachedContext.curveCache = &cachedCurves;
+	uncachedContext.curveCache = &uncachedCurves;
+	chrono::duration<double, milli> cachedTime(0), uncachedTime(0);
+	DisplayList cachedDisplayList, uncachedDisplayList;
+	for (auto round = 0; round < nRounds; ++round) {
+		auto const& startTime = chrono::steady_clock::now();
+		updateDesign(cachedContext, teeth, rpds, cachedDisplayList, true, false, round == 0);
+		auto const& midTime = chrono::steady_clock::now();
+		updateDesign(uncachedContext, teeth, rpds, uncachedDisplayList, true, false, round == 0);
+		auto const& endTime = chrono::steady_clock::now();
+		cachedTime += midTime - startTime;
+		uncachedTime += endTime - midTime;
+	}
+	Mat cachedImages[2]{designImages[0]}, uncachedImages[2]{designImages[0]};
+	rasterizeDesign(cachedDisplayList, cachedImages);
+	rasterizeDesign(uncachedDisplayList, uncachedImages);
+	cout << fixed << setprecision(1) << cachedDisplayList.getNComponents() << " components, " << static_cast<double>(cachedCurves.getHits()) / nRounds << " string curves reused and " << static_cast<double>(cachedCurves.getMisses()) / nRounds << " computed per design" << endl;
+	cout << "  cached " << cachedTime.count() / nRounds << " ms, uncached " << uncachedTime.count() / nRounds << " ms per design (" << uncachedTime.count() / cachedTime.count() << "x)" << endl;
+	return countNonZero(cachedImages[1] != uncachedImages[1]) == 0;
+}
+
+struct Benchmark {
+	char const* name;
+	int imreadFlags;
+	bool needsDesign, acceptsScale;
+	bool (*run)(Mat const& base, string const& rpdFileName, double const& scale);
+	char const* failure;
+};
+
+Benchmark const benchmarks[]{
+	{"--benchmark-angle-points", IMREAD_GRAYSCALE, false, true, [](Mat const& base, string const&, double const& scale) { return benchmarkAnglePoints(base, scale); }, "Angle points differ from the reference sweep"},
+	{"--benchmark-normals", IMREAD_COLOR, false, false, [](Mat const& base, string const&, double const&) { return benchmarkNormals(base); }, "Normal directions exceed the accuracy bound"},
+	{"--benchmark-shades", IMREAD_COLOR, true, true, benchmarkShades, "Clipped shades differ from the full-frame ones"},
+	{"--benchmark-parallel", IMREAD_COLOR, true, true, benchmarkParallel, "Rasterized designs differ from drawing every component straight onto the image"},
+	{"--benchmark-incremental", IMREAD_COLOR, true, false, [](Mat const& base, string const& rpdFileName, double const&) { return benchmarkIncremental(base, rpdFileName); }, "Incremental designs differ from the full ones"},
+	{"--benchmark-curve-cache", IMREAD_COLOR, true, false, [](Mat const& base, string const& rpdFileName, double const&) { return benchmarkCurveCache(base, rpdFileName); }, "Designs with cached curves differ from the uncached ones"}
+};
+
+int runBenchmark(Benchmark const& benchmark, vector<string> const& args) {
+	auto const& base = imread(args[0], benchmark.imreadFlags);
+	if (base.empty()) {
+		cerr << "Cannot read base image: " << args[0] << endl;
+		return 1;
+	}
+	auto const& hasScale = args.size() > 1U + benchmark.needsDesign;
+	auto const& scale = hasScale ? atof(args.back().c_str()) : 1;
+	if (scale <= 0) {
+		cerr << "Not a valid scale: " << args.back() << endl;
+		return 1;
+	}
+	if (!benchmark.run(base, benchmark.needsDesign ? args[1] : string(), scale)) {
+		cerr << benchmark.failure << endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc == 4 && string(argv[1]) == "--default-base") {
+		if (!writeDefaultBase(argv[2], argv[3])) {
+			cerr << "Cannot analyze default base: " << argv[2] << endl;
+			return 1;
+		}
+		cout << "Generated default base data " << argv[3] << endl;
+		return 0;
+	}
+	for (auto benchmark = begin(benchmarks); benchmark < end(benchmarks); ++benchmark)
+		if (argc >= 3 && string(argv[1]) == benchmark->name) {
+			auto const& nArgs = 3 + benchmark->needsDesign;
+			if (argc == nArgs || (benchmark->acceptsScale && argc == nArgs + 1))
+				return runBenchmark(*benchmark, vector<string>(argv + 2, argv + argc));
+		}
+	if (argc != 3) {
+		cerr << "Usage: " << argv[0] << " <ontology.owl> <design.rpds>" << endl;
+		cerr << "       " << argv[0] << " --default-base <base.png> <DefaultBaseData.inc>" << endl;
+		for (auto benchmark = begin(benchmarks); benchmark < end(benchmarks); ++benchmark)
+			cerr << "       " << argv[0] << ' ' << benchmark->name << " <base.png>" << (benchmark->needsDesign ? " <ontology.owl>" : "") << (benchmark->acceptsScale ? " [scale]" : "") << endl;
+		return 1;
+	}
+	vector<Individual> individuals, loadedIndividuals;
+	if (!OwlReader::read(argv[1], individuals)) {
+		cerr << "Not a valid ontology: " << argv[1] << endl;
+		return 1;
+	}
+	if (!DesignSpec::write(argv[2], individuals)) {
+		cerr << "Cannot write design spec: " << argv[2] << endl;
+		return 1;
+	}
+	if (!DesignSpec::read(argv[2], loadedIndividuals) || loadedIndividuals != individuals) {
+		cerr << "Design spec does not round-trip: " << argv[2] << endl;
+		return 1;
+	}
+	cout << "Compiled " << individuals.size() << " individuals into " << argv[2] << endl;
+	return 0;
+}
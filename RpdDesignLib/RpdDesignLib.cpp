@@ -1,43 +1,302 @@
 #include <opencv2/highgui/highgui.hpp>
+#include <sstream>
 
 #include "dllmain.h"
 #include "RpdDesignLib.h"
-#include "../RpdDesign/resource.h"
-#include "../RpdDesign/Tooth.h"
+#include "../RpdDesign/BaseImageCache.h"
+#include "../RpdDesign/DefaultBase.h"
+#include "../RpdDesign/DisplayList.h"
+#include "../RpdDesign/JniRegistry.h"
+#include "../RpdDesign/TeethModel.h"
 #include "../RpdDesign/Utilities.h"
+#include "../RpdDesign/WorkerPool.h"
+
+JavaVM* javaVm;
+
+mutex workerPoolMutex;
+
+auto& workerPool = *new shared_ptr<WorkerPool>;
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+	JNIEnv* env;
+	if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8) != JNI_OK)
+		return JNI_ERR;
+	javaVm = vm;
+	JniRegistry::load(env);
+	if (auto const& cacheDirectory = getenv("RPD_DESIGN_CACHE_DIR"))
+		BaseImageCache::setDirectory(cacheDirectory);
+	return JNI_VERSION_1_8;
+}
+
+shared_ptr<WorkerPool> replaceWorkerPool(shared_ptr<WorkerPool> thisWorkerPool) {
+	lock_guard<mutex> lock(workerPoolMutex);
+	workerPool.swap(thisWorkerPool);
+	return thisWorkerPool;
+}
+
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM* vm, void*) {
+	replaceWorkerPool(nullptr);
+	JNIEnv* env;
+	if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_8) == JNI_OK)
+		JniRegistry::unload(env);
+}
+
+void throwRuntimeException(JNIEnv* const& env, char const* const& message) {
+	auto const& clsRuntimeException = env->FindClass("java/lang/RuntimeException");
+	env->ThrowNew(clsRuntimeException, message);
+	env->DeleteLocalRef(clsRuntimeException);
+}
+
+JniRegistry const* getMatRegistry(JNIEnv* const& env) {
+	auto const& registry = JniRegistry::getMat();
+	if (!registry)
+		throwRuntimeException(env, "org.opencv.core.Mat is not available to RpdDesignLib");
+	return registry;
+}
+
+bool hasOntologyRegistry(JNIEnv* const& env) {
+	auto const& hasRegistry = JniRegistry::getOntology() != nullptr;
+	if (!hasRegistry)
+		throwRuntimeException(env, "Jena is not available to RpdDesignLib");
+	return hasRegistry;
+}
 
 jobject matToJMat(JNIEnv* const& env, Mat const& mat) {
-	auto const& clsStrMat = "org/opencv/core/Mat";
-	auto const& clsMat = env->FindClass(clsStrMat);
-	auto const& midMatInit = env->GetMethodID(clsMat, "<init>", "()V");
-	auto const& jMat = env->NewObject(clsMat, midMatInit);
-	auto const& midGetNativeObjAddr = env->GetMethodID(clsMat, "getNativeObjAddr", "()J");
-	*reinterpret_cast<Mat*>(env->CallLongMethod(jMat, midGetNativeObjAddr)) = mat;
+	auto const& registry = getMatRegistry(env);
+	if (!registry)
+		return nullptr;
+	auto const& jMat = env->NewObject(registry->clsMat, registry->midMatInit);
+	*reinterpret_cast<Mat*>(env->CallLongMethod(jMat, registry->midGetNativeObjAddr)) = mat;
 	return jMat;
 }
 
-Mat& jMatToMat(JNIEnv* const& env, jobject const& jMat) {
-	auto const& clsStrMat = "org/opencv/core/Mat";
-	auto const& clsMat = env->FindClass(clsStrMat);
-	auto const& midGetNativeObjAddr = env->GetMethodID(clsMat, "getNativeObjAddr", "()J");
-	return *reinterpret_cast<Mat*>(env->CallLongMethod(jMat, midGetNativeObjAddr));
+Mat* jMatToMat(JNIEnv* const& env, jobject const& jMat) {
+	auto const& registry = getMatRegistry(env);
+	return registry ? reinterpret_cast<Mat*>(env->CallLongMethod(jMat, registry->midGetNativeObjAddr)) : nullptr;
+}
+
+Mat getRpdDesign(DesignContext const& context, RpdStore& rpds, TeethModel& teeth, Mat (&designImages)[2]) {
+	DisplayList displayList;
+	updateDesign(context, teeth, rpds, displayList, true, true, true);
+	rasterizeDesign(displayList, designImages);
+	bitwise_and(designImages[0], designImages[1], designImages[0]);
+	return designImages[0];
+}
+
+Mat getRpdDesign(DesignContext& context, RpdStore& rpds, Mat const* const& base = nullptr) {
+	TeethModel teeth;
+	Mat designImages[2];
+	if (base)
+		BaseImageCache::analyze(*base, context, teeth, designImages);
+	else
+		DefaultBase::load(context, teeth, designImages);
+	return getRpdDesign(context, rpds, teeth, designImages);
+}
+
+shared_ptr<WorkerPool> getWorkerPool() {
+	lock_guard<mutex> lock(workerPoolMutex);
+	if (!workerPool) {
+		auto const& nWorkers = getenv("RPD_DESIGN_WORKERS");
+		workerPool = nWorkers ? make_shared<WorkerPool>(max(atoi(nWorkers), 1)) : make_shared<WorkerPool>();
+	}
+	return workerPool;
+}
+
+Mat getRpdDesign(Mat const& base, function<void(RpdStore&, bool (&)[nZones])> const& query) {
+	DesignContext context;
+	TeethModel teeth;
+	Mat designImages[2];
+	auto analysis = getWorkerPool()->submit([&base, &context, &teeth, &designImages] { BaseImageCache::analyze(base, context, teeth, designImages); });
+	RpdStore rpds;
+	bool isEighthToothUsed[nZones]{};
+	try {
+		query(rpds, isEighthToothUsed);
+	}
+	catch (...) {
+		analysis.wait();
+		throw;
+	}
+	analysis.get();
+	copy(begin(isEighthToothUsed), end(isEighthToothUsed), context.isEighthUsed);
+	return getRpdDesign(context, rpds, teeth, designImages);
 }
 
 JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Lorg_apache_jena_ontology_OntModel_2Lorg_opencv_core_Mat_2(JNIEnv* env, jclass, jobject ontModel, jobject base) {
-	vector<Tooth> teeth[nZones];
+	if (!hasOntologyRegistry(env))
+		return nullptr;
+	auto const& thisBase = jMatToMat(env, base);
+	if (!thisBase)
+		return nullptr;
+	auto const& design = getRpdDesign(*thisBase, [env, ontModel](RpdStore& rpds, bool (&isEighthToothUsed)[nZones]) { queryRpds(env, ontModel, rpds, isEighthToothUsed); });
+	return env->ExceptionCheck() ? nullptr : matToJMat(env, design);
+}
+
+JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Lorg_apache_jena_ontology_OntModel_2(JNIEnv* env, jclass, jobject ontModel) {
+	if (!hasOntologyRegistry(env))
+		return nullptr;
+	DesignContext context;
+	RpdStore rpds;
+	queryRpds(env, ontModel, rpds, context.isEighthUsed);
+	return env->ExceptionCheck() ? nullptr : matToJMat(env, getRpdDesign(context, rpds));
+}
+
+JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Ljava_lang_String_2Lorg_opencv_core_Mat_2(JNIEnv* env, jclass, jstring owlPath, jobject base) {
+	auto const& thisBase = jMatToMat(env, base);
+	return thisBase ? matToJMat(env, getRpdDesign(*thisBase, [env, owlPath](RpdStore& rpds, bool (&isEighthToothUsed)[nZones]) {
+		auto const& owlPathChars = env->GetStringUTFChars(owlPath, nullptr);
+		queryRpds(owlPathChars, rpds, isEighthToothUsed);
+		env->ReleaseStringUTFChars(owlPath, owlPathChars);
+	})) : nullptr;
+}
+
+JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Ljava_lang_String_2(JNIEnv* env, jclass, jstring owlPath) {
+	auto const& owlPathChars = env->GetStringUTFChars(owlPath, nullptr);
+	DesignContext context;
+	RpdStore rpds;
+	queryRpds(owlPathChars, rpds, context.isEighthUsed);
+	env->ReleaseStringUTFChars(owlPath, owlPathChars);
+	return matToJMat(env, getRpdDesign(context, rpds));
+}
+
+jbyteArray getRpdDesignVector(JNIEnv* const& env, DesignContext& context, RpdStore& rpds, Mat const* const& base, bool const& asPdf) {
+	TeethModel teeth;
 	Mat designImages[2];
-	analyzeBaseImage(jMatToMat(env, base), teeth, designImages);
-	vector<Rpd*> rpds;
-	queryRpds(env, ontModel, rpds);
-	updateDesign(teeth, rpds, designImages, true, true, true);
-	for (auto rpd = rpds.begin(); rpd < rpds.end(); ++rpd)
-		delete *rpd;
-	bitwise_and(designImages[0], designImages[1], designImages[0]);
-	return matToJMat(env, designImages[0]);
+	if (base)
+		BaseImageCache::analyze(*base, context, teeth, designImages);
+	else
+		DefaultBase::load(context, teeth, designImages);
+	DisplayList displayList;
+	updateDesign(context, teeth, rpds, displayList, true, true, true);
+	ostringstream stream;
+	exportDesign(teeth, displayList, designImages[0].size(), stream, asPdf);
+	auto const& document = stream.str();
+	auto const& jDocument = env->NewByteArray(document.size());
+	env->SetByteArrayRegion(jDocument, 0, document.size(), reinterpret_cast<jbyte const*>(document.data()));
+	return jDocument;
+}
+
+jbyteArray getRpdDesignVector(JNIEnv* const& env, jobject const& ontModel, Mat const* const& base, bool const& asPdf) {
+	if (!hasOntologyRegistry(env))
+		return nullptr;
+	DesignContext context;
+	RpdStore rpds;
+	queryRpds(env, ontModel, rpds, context.isEighthUsed);
+	return env->ExceptionCheck() ? nullptr : getRpdDesignVector(env, context, rpds, base, asPdf);
+}
+
+jbyteArray getRpdDesignVector(JNIEnv* const& env, jstring const& owlPath, Mat const* const& base, bool const& asPdf) {
+	auto const& owlPathChars = env->GetStringUTFChars(owlPath, nullptr);
+	DesignContext context;
+	RpdStore rpds;
+	queryRpds(owlPathChars, rpds, context.isEighthUsed);
+	env->ReleaseStringUTFChars(owlPath, owlPathChars);
+	return getRpdDesignVector(env, context, rpds, base, asPdf);
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_shengjie_Main_getRpdDesignVector__Lorg_apache_jena_ontology_OntModel_2Lorg_opencv_core_Mat_2Z(JNIEnv* env, jclass, jobject ontModel, jobject base, jboolean asPdf) {
+	auto const& thisBase = jMatToMat(env, base);
+	return thisBase ? getRpdDesignVector(env, ontModel, thisBase, asPdf) : nullptr;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_shengjie_Main_getRpdDesignVector__Lorg_apache_jena_ontology_OntModel_2Z(JNIEnv* env, jclass, jobject ontModel, jboolean asPdf) { return getRpdDesignVector(env, ontModel, nullptr, asPdf); }
+
+JNIEXPORT jbyteArray JNICALL Java_com_shengjie_Main_getRpdDesignVector__Ljava_lang_String_2Lorg_opencv_core_Mat_2Z(JNIEnv* env, jclass, jstring owlPath, jobject base, jboolean asPdf) {
+	auto const& thisBase = jMatToMat(env, base);
+	return thisBase ? getRpdDesignVector(env, owlPath, thisBase, asPdf) : nullptr;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_shengjie_Main_getRpdDesignVector__Ljava_lang_String_2Z(JNIEnv* env, jclass, jstring owlPath, jboolean asPdf) { return getRpdDesignVector(env, owlPath, nullptr, asPdf); }
+
+class JavaThread {
+public:
+	JavaThread() {
+		if (javaVm->GetEnv(reinterpret_cast<void**>(&env_), JNI_VERSION_1_8) != JNI_EDETACHED)
+			return;
+		isAttached_ = javaVm->AttachCurrentThreadAsDaemon(reinterpret_cast<void**>(&env_), nullptr) == JNI_OK;
+		if (!isAttached_)
+			env_ = nullptr;
+	}
+	JavaThread(JavaThread const&) = delete;
+	~JavaThread() {
+		if (!isAttached_)
+			return;
+		env_->ExceptionClear();
+		javaVm->DetachCurrentThread();
+	}
+	JavaThread& operator=(JavaThread const&) = delete;
+	JNIEnv* const& getEnv() const { return env_; }
+private:
+	JNIEnv* env_ = nullptr;
+	bool isAttached_ = false;
+};
+
+jlong submitRpdDesignJob(JNIEnv* const& env, jobject const& ontModel, Mat const* const& base = nullptr) {
+	if (!hasOntologyRegistry(env))
+		return 0;
+	shared_ptr<_jobject> const globalOntModel(env->NewGlobalRef(ontModel), [](jobject const& object) {
+		JavaThread const thread;
+		if (thread.getEnv())
+			thread.getEnv()->DeleteGlobalRef(object);
+	});
+	auto const& thisBase = base ? base->clone() : Mat();
+	return reinterpret_cast<jlong>(new future<Mat>(getWorkerPool()->submit([globalOntModel, thisBase] {
+		DesignContext context;
+		RpdStore rpds;
+		{
+			JavaThread const thread;
+			auto const& env = thread.getEnv();
+			if (!env)
+				throw runtime_error("Cannot attach the worker to the Java VM");
+			queryRpds(env, globalOntModel.get(), rpds, context.isEighthUsed);
+			if (env->ExceptionCheck())
+				throw runtime_error("Cannot read the Ontology model");
+		}
+		return getRpdDesign(context, rpds, thisBase.data ? &thisBase : nullptr);
+	})));
+}
+
+jlong submitRpdDesignJob(JNIEnv* const& env, jstring const& owlPath, Mat const* const& base = nullptr) {
+	auto const& owlPathChars = env->GetStringUTFChars(owlPath, nullptr);
+	string const thisOwlPath = owlPathChars;
+	env->ReleaseStringUTFChars(owlPath, owlPathChars);
+	auto const& thisBase = base ? base->clone() : Mat();
+	return reinterpret_cast<jlong>(new future<Mat>(getWorkerPool()->submit([thisOwlPath, thisBase] {
+		DesignContext context;
+		RpdStore rpds;
+		queryRpds(thisOwlPath, rpds, context.isEighthUsed);
+		return getRpdDesign(context, rpds, thisBase.data ? &thisBase : nullptr);
+	})));
+}
+
+JNIEXPORT jlong JNICALL Java_com_shengjie_Main_submitRpdDesignJob__Lorg_apache_jena_ontology_OntModel_2Lorg_opencv_core_Mat_2(JNIEnv* env, jclass, jobject ontModel, jobject base) {
+	auto const& thisBase = jMatToMat(env, base);
+	return thisBase ? submitRpdDesignJob(env, ontModel, thisBase) : 0;
 }
 
-JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Lorg_apache_jena_ontology_OntModel_2(JNIEnv* env, jclass cls, jobject ontModel) {
-	auto const& hRsrc = FindResource(dllHandle, MAKEINTRESOURCE(IDB_PNG1), TEXT("PNG"));
-	auto const& pBuf = static_cast<uchar*>(LockResource(LoadResource(dllHandle, hRsrc)));
-	return Java_com_shengjie_Main_getRpdDesign__Lorg_apache_jena_ontology_OntModel_2Lorg_opencv_core_Mat_2(env, cls, ontModel, matToJMat(env, imdecode(vector<uchar>(pBuf, pBuf + SizeofResource(dllHandle, hRsrc)), IMREAD_COLOR)));
+JNIEXPORT jlong JNICALL Java_com_shengjie_Main_submitRpdDesignJob__Lorg_apache_jena_ontology_OntModel_2(JNIEnv* env, jclass, jobject ontModel) { return submitRpdDesignJob(env, ontModel); }
+
+JNIEXPORT jlong JNICALL Java_com_shengjie_Main_submitRpdDesignJob__Ljava_lang_String_2Lorg_opencv_core_Mat_2(JNIEnv* env, jclass, jstring owlPath, jobject base) {
+	auto const& thisBase = jMatToMat(env, base);
+	return thisBase ? submitRpdDesignJob(env, owlPath, thisBase) : 0;
+}
+
+JNIEXPORT jlong JNICALL Java_com_shengjie_Main_submitRpdDesignJob__Ljava_lang_String_2(JNIEnv* env, jclass, jstring owlPath) { return submitRpdDesignJob(env, owlPath); }
+
+JNIEXPORT jboolean JNICALL Java_com_shengjie_Main_isRpdDesignJobDone(JNIEnv*, jclass, jlong handle) { return reinterpret_cast<future<Mat>*>(handle)->wait_for(chrono::seconds(0)) == future_status::ready; }
+
+JNIEXPORT jobject JNICALL Java_com_shengjie_Main_awaitRpdDesignJob(JNIEnv* env, jclass, jlong handle) {
+	unique_ptr<future<Mat>> const job(reinterpret_cast<future<Mat>*>(handle));
+	try {
+		return matToJMat(env, job->get());
+	}
+	catch (exception const& e) {
+		throwRuntimeException(env, e.what());
+		return nullptr;
+	}
+}
+
+JNIEXPORT void JNICALL Java_com_shengjie_Main_releaseRpdDesignJob(JNIEnv*, jclass, jlong handle) { delete reinterpret_cast<future<Mat>*>(handle); }
+
+JNIEXPORT void JNICALL Java_com_shengjie_Main_setWorkerCount(JNIEnv*, jclass, jint nWorkers) {
+	replaceWorkerPool(make_shared<WorkerPool>(max<jint>(nWorkers, 1)));
 }
@@ -18,7 +18,105 @@ extern "C" {
 	 * Method:    getRpdDesign
 	 * Signature: (Lorg/apache/jena/ontology/OntModel;)Lorg/opencv/core/Mat;
 	 */
-	JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Lorg_apache_jena_ontology_OntModel_2(JNIEnv* env, jclass cls, jobject ontModel);
+	JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Lorg_apache_jena_ontology_OntModel_2(JNIEnv* env, jclass, jobject ontModel);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    getRpdDesign
+	 * Signature: (Ljava/lang/String;Lorg/opencv/core/Mat;)Lorg/opencv/core/Mat;
+	 */
+	JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Ljava_lang_String_2Lorg_opencv_core_Mat_2(JNIEnv* env, jclass, jstring owlPath, jobject base);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    getRpdDesign
+	 * Signature: (Ljava/lang/String;)Lorg/opencv/core/Mat;
+	 */
+	JNIEXPORT jobject JNICALL Java_com_shengjie_Main_getRpdDesign__Ljava_lang_String_2(JNIEnv* env, jclass, jstring owlPath);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    getRpdDesignVector
+	 * Signature: (Lorg/apache/jena/ontology/OntModel;Lorg/opencv/core/Mat;Z)[B
+	 */
+	JNIEXPORT jbyteArray JNICALL Java_com_shengjie_Main_getRpdDesignVector__Lorg_apache_jena_ontology_OntModel_2Lorg_opencv_core_Mat_2Z(JNIEnv* env, jclass, jobject ontModel, jobject base, jboolean asPdf);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    getRpdDesignVector
+	 * Signature: (Lorg/apache/jena/ontology/OntModel;Z)[B
+	 */
+	JNIEXPORT jbyteArray JNICALL Java_com_shengjie_Main_getRpdDesignVector__Lorg_apache_jena_ontology_OntModel_2Z(JNIEnv* env, jclass, jobject ontModel, jboolean asPdf);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    getRpdDesignVector
+	 * Signature: (Ljava/lang/String;Lorg/opencv/core/Mat;Z)[B
+	 */
+	JNIEXPORT jbyteArray JNICALL Java_com_shengjie_Main_getRpdDesignVector__Ljava_lang_String_2Lorg_opencv_core_Mat_2Z(JNIEnv* env, jclass, jstring owlPath, jobject base, jboolean asPdf);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    getRpdDesignVector
+	 * Signature: (Ljava/lang/String;Z)[B
+	 */
+	JNIEXPORT jbyteArray JNICALL Java_com_shengjie_Main_getRpdDesignVector__Ljava_lang_String_2Z(JNIEnv* env, jclass, jstring owlPath, jboolean asPdf);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    submitRpdDesignJob
+	 * Signature: (Lorg/apache/jena/ontology/OntModel;Lorg/opencv/core/Mat;)J
+	 */
+	JNIEXPORT jlong JNICALL Java_com_shengjie_Main_submitRpdDesignJob__Lorg_apache_jena_ontology_OntModel_2Lorg_opencv_core_Mat_2(JNIEnv* env, jclass, jobject ontModel, jobject base);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    submitRpdDesignJob
+	 * Signature: (Lorg/apache/jena/ontology/OntModel;)J
+	 */
+	JNIEXPORT jlong JNICALL Java_com_shengjie_Main_submitRpdDesignJob__Lorg_apache_jena_ontology_OntModel_2(JNIEnv* env, jclass, jobject ontModel);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    submitRpdDesignJob
+	 * Signature: (Ljava/lang/String;Lorg/opencv/core/Mat;)J
+	 */
+	JNIEXPORT jlong JNICALL Java_com_shengjie_Main_submitRpdDesignJob__Ljava_lang_String_2Lorg_opencv_core_Mat_2(JNIEnv* env, jclass, jstring owlPath, jobject base);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    submitRpdDesignJob
+	 * Signature: (Ljava/lang/String;)J
+	 */
+	JNIEXPORT jlong JNICALL Java_com_shengjie_Main_submitRpdDesignJob__Ljava_lang_String_2(JNIEnv* env, jclass, jstring owlPath);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    isRpdDesignJobDone
+	 * Signature: (J)Z
+	 */
+	JNIEXPORT jboolean JNICALL Java_com_shengjie_Main_isRpdDesignJobDone(JNIEnv*, jclass, jlong handle);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    awaitRpdDesignJob
+	 * Signature: (J)Lorg/opencv/core/Mat;
+	 */
+	JNIEXPORT jobject JNICALL Java_com_shengjie_Main_awaitRpdDesignJob(JNIEnv* env, jclass, jlong handle);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    releaseRpdDesignJob
+	 * Signature: (J)V
+	 */
+	JNIEXPORT void JNICALL Java_com_shengjie_Main_releaseRpdDesignJob(JNIEnv*, jclass, jlong handle);
+
+	/*
+	 * Class:     com_shengjie_Main
+	 * Method:    setWorkerCount
+	 * Signature: (I)V
+	 */
+	JNIEXPORT void JNICALL Java_com_shengjie_Main_setWorkerCount(JNIEnv*, jclass, jint nWorkers);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,80 @@
+package com.shengjie;
+
+import org.apache.jena.ontology.OntModel;
+import org.apache.jena.ontology.OntModelSpec;
+import org.apache.jena.rdf.model.ModelFactory;
+import org.opencv.core.Mat;
+import org.opencv.core.Size;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import static org.opencv.imgcodecs.Imgcodecs.imread;
+import static org.opencv.imgproc.Imgproc.INTER_LINEAR;
+import static org.opencv.imgproc.Imgproc.resize;
+
+public class ConcurrencyTest {
+    private static final String owlPath = "../sample/sample.owl";
+    private static final int nDesigns = 64, nThreads = Runtime.getRuntime().availableProcessors();
+
+    private static byte[] toBytes(Mat mat) {
+        byte[] bytes = new byte[(int) mat.total() * mat.channels()];
+        mat.get(0, 0, bytes);
+        mat.release();
+        return bytes;
+    }
+
+    private static Mat scale(Mat base, double factor) {
+        Mat scaledBase = new Mat();
+        resize(base, scaledBase, new Size(), factor, factor, INTER_LINEAR);
+        return scaledBase;
+    }
+
+    private static OntModel readOntModel() {
+        OntModel ontModel = ModelFactory.createOntologyModel(OntModelSpec.OWL_DL_MEM);
+        ontModel.read(owlPath);
+        return ontModel;
+    }
+
+    private static Callable<byte[]> createTask(int i, Mat base) {
+        switch (i % 4) {
+            case 0:
+                return () -> toBytes(Main.getRpdDesign(owlPath));
+            case 1: {
+                Mat thisBase = scale(base, 1 + i / 256.0);
+                return () -> toBytes(Main.getRpdDesign(owlPath, thisBase));
+            }
+            case 2: {
+                OntModel ontModel = readOntModel();
+                return () -> toBytes(Main.getRpdDesign(ontModel));
+            }
+            default: {
+                OntModel ontModel = readOntModel();
+                Mat thisBase = scale(base, 1 + i / 256.0);
+                return () -> toBytes(Main.getRpdDesign(ontModel, thisBase));
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Mat base = imread("../sample/base.png");
+        List<Callable<byte[]>> tasks = new ArrayList<>();
+        for (int i = 0; i < nDesigns; ++i)
+            tasks.add(createTask(i, base));
+        ExecutorService executor = Executors.newFixedThreadPool(nThreads);
+        List<Future<byte[]>> futures = executor.invokeAll(tasks);
+        executor.shutdown();
+        int nMismatches = 0;
+        for (int i = 0; i < nDesigns; ++i)
+            if (!Arrays.equals(futures.get(i).get(), tasks.get(i).call()))
+                ++nMismatches;
+        System.out.printf("%d designs on %d threads, %d differ from serial rendering%n", nDesigns, nThreads, nMismatches);
+        if (nMismatches > 0)
+            System.exit(1);
+    }
+}
@@ -0,0 +1,121 @@
+package com.shengjie;
+
+import org.apache.jena.ontology.Individual;
+import org.apache.jena.ontology.OntClass;
+import org.apache.jena.ontology.OntModel;
+import org.apache.jena.rdf.model.Property;
+import org.apache.jena.rdf.model.RDFNode;
+import org.apache.jena.rdf.model.Resource;
+import org.apache.jena.rdf.model.ResourceFactory;
+import org.apache.jena.rdf.model.Statement;
+import org.apache.jena.rdf.model.StmtIterator;
+import org.apache.jena.util.iterator.ExtendedIterator;
+
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.Map;
+
+public class IndividualFlattener {
+    private static final int CLASS_ID = 0, CLASP_MATERIAL = 1, CLASP_TIP_DIRECTION = 2, CLASP_TIP_SIDE = 3, ENABLE_BUCCAL_ARM = 4, ENABLE_LINGUAL_ARM = 5, ENABLE_REST = 6, IS_MISSING = 7, REST_MESIAL_OR_DISTAL = 8, N_POSITIONS = 9, N_LINGUAL_CONFRONTATIONS = 10, POSITIONS = 11, LINGUAL_CONFRONTATIONS = 12, N_COLUMNS = 13;
+
+    public static final String disableProperty = "com.shengjie.IndividualFlattener.disable";
+
+    private static final String ontPrefix = "http://www.semanticweb.org/msiip/ontologies/CDSSinRPD#";
+
+    private static final Property claspMaterial = createProperty("clasp_material");
+    private static final Property claspTipDirection = createProperty("clasp_tip_direction");
+    private static final Property claspTipSide = createProperty("clasp_tip_side");
+    private static final Property componentPosition = createProperty("component_position");
+    private static final Property enableBuccalArm = createProperty("enable_buccal_arm");
+    private static final Property enableLingualArm = createProperty("enable_lingual_arm");
+    private static final Property enableRest = createProperty("enable_rest");
+    private static final Property isMissing = createProperty("is_missing");
+    private static final Property lingualConfrontation = createProperty("lingual_confrontation");
+    private static final Property restMesialOrDistal = createProperty("rest_mesial_or_distal");
+    private static final Property toothOrdinal = createProperty("tooth_ordinal");
+    private static final Property toothZone = createProperty("tooth_zone");
+
+    private static class IntColumn {
+        private int[] data = new int[64];
+        private int size = 0;
+
+        void add(int value) {
+            if (size == data.length)
+                data = Arrays.copyOf(data, size * 2);
+            data[size++] = value;
+        }
+
+        int[] toArray() {
+            return Arrays.copyOf(data, size);
+        }
+    }
+
+    private static Property createProperty(String localName) {
+        return ResourceFactory.createProperty(ontPrefix + localName);
+    }
+
+    private static int getInt(Resource resource, Property property) {
+        Statement statement = resource.getProperty(property);
+        return statement == null ? -1 : statement.getInt();
+    }
+
+    private static int getBoolean(Individual individual, Property property) {
+        Statement statement = individual.getProperty(property);
+        return statement == null ? -1 : statement.getBoolean() ? 1 : 0;
+    }
+
+    private static int addPositions(Individual individual, Property property, IntColumn column) {
+        int nPositions = 0;
+        for (StmtIterator teeth = individual.listProperties(property); teeth.hasNext(); ) {
+            RDFNode tooth = teeth.next().getObject();
+            if (!tooth.isResource())
+                continue;
+            int zone = getInt(tooth.asResource(), toothZone), ordinal = getInt(tooth.asResource(), toothOrdinal);
+            if (zone < 1 || ordinal < 1)
+                continue;
+            column.add(zone - 1);
+            column.add(ordinal - 1);
+            ++nPositions;
+        }
+        return nPositions;
+    }
+
+    public static int[][] flatten(OntModel ontModel, String[] classNames) {
+        if (Boolean.getBoolean(disableProperty))
+            return null;
+        Map<String, Integer> classIds = new HashMap<>();
+        for (int i = 0; i < classNames.length; ++i)
+            classIds.put(classNames[i], i);
+        IntColumn[] columns = new IntColumn[N_COLUMNS];
+        for (int i = 0; i < N_COLUMNS; ++i)
+            columns[i] = new IntColumn();
+        for (ExtendedIterator<Individual> individuals = ontModel.listIndividuals(); individuals.hasNext(); ) {
+            Individual individual = individuals.next();
+            OntClass ontClass = individual.getOntClass();
+            Integer classId = ontClass == null ? null : classIds.get(ontClass.getLocalName());
+            if (classId == null)
+                continue;
+            columns[CLASS_ID].add(classId);
+            columns[CLASP_MATERIAL].add(getInt(individual, claspMaterial));
+            columns[CLASP_TIP_DIRECTION].add(getInt(individual, claspTipDirection));
+            columns[CLASP_TIP_SIDE].add(getInt(individual, claspTipSide));
+            columns[ENABLE_BUCCAL_ARM].add(getBoolean(individual, enableBuccalArm));
+            columns[ENABLE_LINGUAL_ARM].add(getBoolean(individual, enableLingualArm));
+            columns[ENABLE_REST].add(getBoolean(individual, enableRest));
+            columns[IS_MISSING].add(getBoolean(individual, isMissing));
+            columns[REST_MESIAL_OR_DISTAL].add(getInt(individual, restMesialOrDistal));
+            if (individual.hasProperty(toothZone) && individual.hasProperty(toothOrdinal)) {
+                columns[POSITIONS].add(getInt(individual, toothZone) - 1);
+                columns[POSITIONS].add(getInt(individual, toothOrdinal) - 1);
+                columns[N_POSITIONS].add(1);
+            }
+            else
+                columns[N_POSITIONS].add(addPositions(individual, componentPosition, columns[POSITIONS]));
+            columns[N_LINGUAL_CONFRONTATIONS].add(addPositions(individual, lingualConfrontation, columns[LINGUAL_CONFRONTATIONS]));
+        }
+        int[][] flattened = new int[N_COLUMNS][];
+        for (int i = 0; i < N_COLUMNS; ++i)
+            flattened[i] = columns[i].toArray();
+        return flattened;
+    }
+}
@@ -5,23 +5,75 @@ import org.apache.jena.ontology.OntModelSpec;
 import org.apache.jena.rdf.model.ModelFactory;
 import org.opencv.core.Mat;
 
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+
 import static org.opencv.imgcodecs.Imgcodecs.imread;
 import static org.opencv.imgcodecs.Imgcodecs.imwrite;
 
 public class Main {
     static {
-        System.loadLibrary("RpdDesignLib");
         System.loadLibrary("opencv_java320");
+        System.loadLibrary("RpdDesignLib");
     }
 
     public static native Mat getRpdDesign(OntModel ontModel, Mat mat);
 
     public static native Mat getRpdDesign(OntModel ontModel);
 
-    public static void main(String[] args) {
+    public static native Mat getRpdDesign(String owlPath, Mat mat);
+
+    public static native Mat getRpdDesign(String owlPath);
+
+    public static native byte[] getRpdDesignVector(OntModel ontModel, Mat mat, boolean asPdf);
+
+    public static native byte[] getRpdDesignVector(OntModel ontModel, boolean asPdf);
+
+    public static native byte[] getRpdDesignVector(String owlPath, Mat mat, boolean asPdf);
+
+    public static native byte[] getRpdDesignVector(String owlPath, boolean asPdf);
+
+    private static native long submitRpdDesignJob(OntModel ontModel, Mat mat);
+
+    private static native long submitRpdDesignJob(OntModel ontModel);
+
+    private static native long submitRpdDesignJob(String owlPath, Mat mat);
+
+    private static native long submitRpdDesignJob(String owlPath);
+
+    static native boolean isRpdDesignJobDone(long handle);
+
+    static native Mat awaitRpdDesignJob(long handle);
+
+    static native void releaseRpdDesignJob(long handle);
+
+    public static native void setWorkerCount(int nWorkers);
+
+    public static RpdDesignFuture submitRpdDesign(OntModel ontModel, Mat mat) {
+        return new RpdDesignFuture(submitRpdDesignJob(ontModel, mat));
+    }
+
+    public static RpdDesignFuture submitRpdDesign(OntModel ontModel) {
+        return new RpdDesignFuture(submitRpdDesignJob(ontModel));
+    }
+
+    public static RpdDesignFuture submitRpdDesign(String owlPath, Mat mat) {
+        return new RpdDesignFuture(submitRpdDesignJob(owlPath, mat));
+    }
+
+    public static RpdDesignFuture submitRpdDesign(String owlPath) {
+        return new RpdDesignFuture(submitRpdDesignJob(owlPath));
+    }
+
+    public static void main(String[] args) throws IOException {
         OntModel ontModel = ModelFactory.createOntologyModel(OntModelSpec.OWL_DL_MEM);
         ontModel.read("../sample/sample.owl");
         imwrite("design_with_base.png", getRpdDesign(ontModel, imread("../sample/base.png")));
         imwrite("design.png", getRpdDesign(ontModel));
+        imwrite("design_native_with_base.png", getRpdDesign("../sample/sample.owl", imread("../sample/base.png")));
+        imwrite("design_native.png", getRpdDesign("../sample/sample.owl"));
+        Files.write(Paths.get("design.svg"), getRpdDesignVector(ontModel, false));
+        Files.write(Paths.get("design_native.pdf"), getRpdDesignVector("../sample/sample.owl", true));
     }
 }
@@ -0,0 +1,50 @@
+package com.shengjie;
+
+import org.apache.jena.ontology.OntModel;
+import org.apache.jena.ontology.OntModelSpec;
+import org.apache.jena.rdf.model.ModelFactory;
+import org.opencv.core.Mat;
+
+import java.util.Arrays;
+
+public class ReaderBenchmark {
+    private static final String owlPath = "../sample/sample.owl";
+    private static final int nRounds = 50;
+
+    private static byte[] toBytes(Mat mat) {
+        byte[] bytes = new byte[(int) mat.total() * mat.channels()];
+        mat.get(0, 0, bytes);
+        mat.release();
+        return bytes;
+    }
+
+    private static OntModel readOntModel() {
+        OntModel ontModel = ModelFactory.createOntologyModel(OntModelSpec.OWL_DL_MEM);
+        ontModel.read(owlPath);
+        return ontModel;
+    }
+
+    public static void main(String[] args) {
+        byte[] jenaBytes = toBytes(Main.getRpdDesign(readOntModel())), nativeBytes = toBytes(Main.getRpdDesign(owlPath));
+        long jenaReadTime = 0, jenaDesignTime = 0, nativeDesignTime = 0;
+        for (int i = 0; i < nRounds; ++i) {
+            long startTime = System.nanoTime();
+            OntModel ontModel = readOntModel();
+            long readTime = System.nanoTime();
+            Main.getRpdDesign(ontModel).release();
+            long midTime = System.nanoTime();
+            Main.getRpdDesign(owlPath).release();
+            long endTime = System.nanoTime();
+            jenaReadTime += readTime - startTime;
+            jenaDesignTime += midTime - readTime;
+            nativeDesignTime += endTime - midTime;
+        }
+        double jenaRead = jenaReadTime / 1e6 / nRounds, jenaDesign = jenaDesignTime / 1e6 / nRounds, nativeDesign = nativeDesignTime / 1e6 / nRounds;
+        System.out.printf("Jena: %.1f ms reading + %.1f ms designing from the model%n", jenaRead, jenaDesign);
+        System.out.printf("OwlReader: %.1f ms reading and designing from the path (%.2fx)%n", nativeDesign, (jenaRead + jenaDesign) / nativeDesign);
+        if (!Arrays.equals(jenaBytes, nativeBytes)) {
+            System.out.println("The design read by OwlReader differs from the one read by Jena");
+            System.exit(1);
+        }
+    }
+}
@@ -0,0 +1,46 @@
+package com.shengjie;
+
+import org.opencv.core.Mat;
+
+public class RpdDesignFuture implements AutoCloseable {
+    private long handle;
+    private Mat design;
+    private RuntimeException failure;
+
+    RpdDesignFuture(long handle) {
+        this.handle = handle;
+    }
+
+    public synchronized boolean isDone() {
+        return handle == 0 || Main.isRpdDesignJobDone(handle);
+    }
+
+    public synchronized Mat get() {
+        if (handle != 0) {
+            long thisHandle = handle;
+            handle = 0;
+            try {
+                design = Main.awaitRpdDesignJob(thisHandle);
+            } catch (RuntimeException e) {
+                failure = e;
+            }
+        }
+        if (failure != null)
+            throw failure;
+        return design;
+    }
+
+    @Override
+    public synchronized void close() {
+        if (handle != 0) {
+            long thisHandle = handle;
+            handle = 0;
+            Main.releaseRpdDesignJob(thisHandle);
+        }
+    }
+
+    @Override
+    protected void finalize() {
+        close();
+    }
+}
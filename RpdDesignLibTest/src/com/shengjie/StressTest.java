@@ -0,0 +1,91 @@
+package com.shengjie;
+
+import com.sun.management.OperatingSystemMXBean;
+import org.apache.jena.ontology.Individual;
+import org.apache.jena.ontology.ObjectProperty;
+import org.apache.jena.ontology.OntClass;
+import org.apache.jena.ontology.OntModel;
+import org.apache.jena.ontology.OntModelSpec;
+import org.apache.jena.rdf.model.ModelFactory;
+import org.apache.jena.rdf.model.Property;
+
+import java.lang.management.ManagementFactory;
+
+public class StressTest {
+    private static final String ontPrefix = "http://www.semanticweb.org/msiip/ontologies/CDSSinRPD#";
+    private static final int nTeeth = 100000, nEdentulousSpaces = 1000, nLingualBars = 16, nRounds = 5;
+    private static final long maxHeapGrowth = 16L << 20, maxProcessGrowth = 64L << 20;
+
+    private static Individual getTooth(Individual[] teeth, int zone, int ordinal) {
+        return teeth[(ordinal - 1) * 4 + zone - 1];
+    }
+
+    private static OntModel createSyntheticModel() {
+        OntModel ontModel = ModelFactory.createOntologyModel(OntModelSpec.OWL_DL_MEM);
+        OntClass tooth = ontModel.createClass(ontPrefix + "tooth");
+        OntClass edentulousSpace = ontModel.createClass(ontPrefix + "edentulous_space");
+        OntClass lingualBar = ontModel.createClass(ontPrefix + "lingual_bar");
+        Property isMissing = ontModel.createDatatypeProperty(ontPrefix + "is_missing");
+        Property toothOrdinal = ontModel.createDatatypeProperty(ontPrefix + "tooth_ordinal");
+        Property toothZone = ontModel.createDatatypeProperty(ontPrefix + "tooth_zone");
+        ObjectProperty componentPosition = ontModel.createObjectProperty(ontPrefix + "component_position");
+        ObjectProperty lingualConfrontation = ontModel.createObjectProperty(ontPrefix + "lingual_confrontation");
+        Individual[] teeth = new Individual[nTeeth];
+        for (int i = 0; i < nTeeth; ++i) {
+            teeth[i] = ontModel.createIndividual(ontPrefix + "tooth" + i, tooth);
+            teeth[i].addLiteral(toothZone, i % 4 + 1);
+            teeth[i].addLiteral(toothOrdinal, i / 4 % 8 + 1);
+            teeth[i].addLiteral(isMissing, i % 2 == 0);
+        }
+        for (int i = 0; i < nEdentulousSpaces; ++i) {
+            Individual individual = ontModel.createIndividual(ontPrefix + "edentulous_space" + i, edentulousSpace);
+            individual.addProperty(componentPosition, getTooth(teeth, i % 4 + 1, 5));
+            individual.addProperty(componentPosition, getTooth(teeth, i % 4 + 1, 6));
+        }
+        for (int i = 0; i < nLingualBars; ++i) {
+            Individual individual = ontModel.createIndividual(ontPrefix + "lingual_bar" + i, lingualBar);
+            individual.addProperty(componentPosition, getTooth(teeth, 3, 4));
+            individual.addProperty(componentPosition, getTooth(teeth, 4, 4));
+            for (int ordinal = 1; ordinal <= 3; ++ordinal) {
+                individual.addProperty(lingualConfrontation, getTooth(teeth, 3, ordinal));
+                individual.addProperty(lingualConfrontation, getTooth(teeth, 4, ordinal));
+            }
+        }
+        return ontModel;
+    }
+
+    private static long getUsedHeap() {
+        System.gc();
+        Runtime runtime = Runtime.getRuntime();
+        return runtime.totalMemory() - runtime.freeMemory();
+    }
+
+    private static long getProcessMemory() {
+        return ((OperatingSystemMXBean) ManagementFactory.getOperatingSystemMXBean()).getCommittedVirtualMemorySize();
+    }
+
+    private static boolean measure(OntModel ontModel, String path) {
+        Main.getRpdDesign(ontModel).release();
+        long baseHeap = getUsedHeap(), baseProcess = getProcessMemory();
+        boolean isBounded = true;
+        for (int i = 0; i < nRounds; ++i) {
+            Main.getRpdDesign(ontModel).release();
+            long heapGrowth = getUsedHeap() - baseHeap, processGrowth = getProcessMemory() - baseProcess;
+            System.out.printf("%s round %d: heap %+d MB, process %+d MB%n", path, i + 1, heapGrowth >> 20, processGrowth >> 20);
+            isBounded = isBounded && heapGrowth <= maxHeapGrowth && processGrowth <= maxProcessGrowth;
+        }
+        return isBounded;
+    }
+
+    public static void main(String[] args) {
+        OntModel ontModel = createSyntheticModel();
+        System.out.printf("%d individuals, %d MB heap in use%n", nTeeth + nEdentulousSpaces + nLingualBars, getUsedHeap() >> 20);
+        boolean isBounded = measure(ontModel, "bulk");
+        System.setProperty(IndividualFlattener.disableProperty, "true");
+        isBounded = measure(ontModel, "per-statement") && isBounded;
+        if (!isBounded) {
+            System.out.printf("Memory grew by more than %d MB of heap or %d MB of process across rounds%n", maxHeapGrowth >> 20, maxProcessGrowth >> 20);
+            System.exit(1);
+        }
+    }
+}
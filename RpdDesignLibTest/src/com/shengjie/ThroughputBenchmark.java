@@ -0,0 +1,31 @@
+package com.shengjie;
+
+import java.util.ArrayList;
+import java.util.List;
+
+public class ThroughputBenchmark {
+    private static final String owlPath = "../sample/sample.owl";
+    private static final int nDesigns = 256;
+
+    private static double measure(int nWorkers) {
+        Main.setWorkerCount(nWorkers);
+        long startTime = System.nanoTime();
+        List<RpdDesignFuture> futures = new ArrayList<>();
+        for (int i = 0; i < nDesigns; ++i)
+            futures.add(Main.submitRpdDesign(owlPath));
+        for (RpdDesignFuture future : futures)
+            future.get().release();
+        return nDesigns / ((System.nanoTime() - startTime) / 1e9);
+    }
+
+    public static void main(String[] args) {
+        int nCores = Runtime.getRuntime().availableProcessors();
+        measure(nCores);
+        double baseline = measure(1);
+        System.out.printf("1 worker: %.1f designs/s%n", baseline);
+        for (int nWorkers = 2; nWorkers <= nCores; nWorkers *= 2) {
+            double throughput = measure(nWorkers);
+            System.out.printf("%d workers: %.1f designs/s, %.2fx%n", nWorkers, throughput, throughput / baseline);
+        }
+    }
+}